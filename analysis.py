@@ -52,6 +52,9 @@ def solve(
     phase,
     **kwargs,
 ):
+    # Each process runs its own solver, so the solver gets a single thread.
+    hgspy.set_num_threads(1)
+
     path = Path(loc)
 
     instance = tools.read_vrplib(path)
@@ -78,7 +81,7 @@ def solve(
 
     best = res.get_best_found()
     routes = [route for route in best.get_routes() if route]
-    cost = best.cost()
+    cost = best.distance()
 
     try:
         actual_cost = tools.validate_static_solution(instance, routes)
@@ -121,7 +124,9 @@ def save_results(instance, res, results_dir, inst_name):
     # Save best solutions
     best = res.get_best_found()
     sol_path = str(make_path(_SOLS_DIR, "txt"))
-    best.export_cvrplib_format(sol_path, res.get_run_time())
+    best.export_cvrplib_format(
+        sol_path, res.get_run_time(), res.get_cost_evaluator()
+    )
 
     # Save statistics
     stats = res.get_statistics()
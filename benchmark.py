@@ -40,6 +40,9 @@ def solve(
     phase,
     **kwargs,
 ):
+    # Each process runs its own solver, so the solver gets a single thread.
+    hgspy.set_num_threads(1)
+
     path = Path(loc)
 
     instance = tools.read_vrplib(path)
@@ -66,7 +69,7 @@ def solve(
 
     best = res.get_best_found()
     routes = [route for route in best.get_routes() if route]
-    cost = best.cost()
+    cost = best.distance()
 
     try:
         actual_cost = tools.validate_static_solution(instance, routes)
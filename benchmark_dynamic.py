@@ -7,6 +7,7 @@ from time import perf_counter
 import numpy as np
 from tqdm.contrib.concurrent import process_map
 
+import hgspy
 import tools
 from environment import VRPEnvironment
 from strategies import solve_dynamic, solve_hindsight
@@ -44,6 +45,9 @@ def solve(
     phase,
     **kwargs,
 ):
+    # Each process runs its own solver, so the solver gets a single thread.
+    hgspy.set_num_threads(1)
+
     path = Path(loc)
 
     if phase is not None:
@@ -0,0 +1,82 @@
+#ifndef BENCHSOLUTION_H
+#define BENCHSOLUTION_H
+
+#include "Individual.h"
+#include "Node.h"
+#include "Params.h"
+#include "Route.h"
+
+#include <vector>
+
+// Nodes and routes of an individual's solution, linked in the same way as the
+// local search does. This lets the benchmark drivers call the operators and
+// route methods directly, without going through the local search.
+class BenchSolution
+{
+public:
+    std::vector<Node> clients;
+    std::vector<Node> startDepots;
+    std::vector<Node> endDepots;
+    std::vector<Route> routes;
+
+    BenchSolution(Params const &params, Individual const &indiv)
+        : clients(params.nbClients + 1),
+          startDepots(params.nbVehicles),
+          endDepots(params.nbVehicles),
+          routes(params.nbVehicles)
+    {
+        for (int i = 0; i <= params.nbClients; i++)
+        {
+            clients[i].params = &params;
+            clients[i].client = i;
+            clients[i].tw = {i,
+                             i,
+                             params.servDur(i),
+                             0,
+                             params.twEarly(i),
+                             params.twLate(i),
+                             params.releaseTime(i)};
+        }
+
+        auto const &routesIndiv = indiv.getRoutes();
+
+        for (int r = 0; r < params.nbVehicles; r++)
+        {
+            Route &route = routes[r];
+            route.params = &params;
+            route.idx = r;
+            route.depot = &startDepots[r];
+
+            for (auto *depot : {&startDepots[r], &endDepots[r]})
+            {
+                depot->params = &params;
+                depot->client = 0;
+                depot->route = &route;
+                depot->tw = clients[0].tw;
+            }
+
+            Node *prev = &startDepots[r];
+
+            for (auto const client : routesIndiv[r])
+            {
+                clients[client].route = &route;
+                clients[client].prev = prev;
+                prev->next = &clients[client];
+                prev = &clients[client];
+            }
+
+            prev->next = &endDepots[r];
+            endDepots[r].prev = prev;
+            endDepots[r].next = &startDepots[r];
+            startDepots[r].prev = &endDepots[r];
+
+            route.update();
+        }
+    }
+
+    // The nodes and routes point to each other, so they cannot be moved.
+    BenchSolution(BenchSolution const &) = delete;
+    BenchSolution &operator=(BenchSolution const &) = delete;
+};
+
+#endif  // BENCHSOLUTION_H
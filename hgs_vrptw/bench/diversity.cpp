@@ -0,0 +1,117 @@
+// Times the broken pairs distance computations of a population insert, run
+// serially and as tasks on the shared scheduler. Usage:
+//
+//     benchDiversity <instance> [<popSize> [<nbThreads> [<nbUpdates>
+//                               [<seed>]]]]
+//
+// Each update computes the distances from a random individual to popSize other
+// random individuals, as Population::addIndividual does. The individuals
+// visit the clients in random order, in routes of 20 clients. The parallel
+// variant splits the distances over one chunk per scheduler thread, regardless
+// of the amount of work. The reported times are the best of three runs of
+// nbUpdates updates.
+
+#include "Config.h"
+#include "Individual.h"
+#include "Params.h"
+#include "TaskScheduler.h"
+#include "XorShift128.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+// Returns the best time per call of update() over three runs, in microseconds.
+template <typename Update> double timePerUpdate(int nbUpdates, Update update)
+{
+    auto best = std::numeric_limits<double>::max();
+
+    for (int run = 0; run != 3; ++run)
+    {
+        auto const start = std::chrono::steady_clock::now();
+
+        for (int count = 0; count != nbUpdates; ++count)
+            update();
+
+        std::chrono::duration<double, std::micro> const elapsed
+            = std::chrono::steady_clock::now() - start;
+
+        best = std::min(best, elapsed.count() / nbUpdates);
+    }
+
+    return best;
+}
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0]
+                  << " <instance> [<popSize> [<nbThreads> [<nbUpdates>"
+                  << " [<seed>]]]]\n";
+        return EXIT_FAILURE;
+    }
+
+    size_t const popSize = argc > 2 ? std::atoi(argv[2]) : 65;
+    auto const nbThreads = argc > 3 ? std::atoi(argv[3]) : 4;
+    auto const nbUpdates = argc > 4 ? std::atoi(argv[4]) : 10'000;
+    auto const seed = argc > 5 ? std::atoi(argv[5]) : 1;
+
+    Config config;
+    XorShift128 rng(seed);
+    Params params(config, argv[1]);
+
+    auto const randomIndividual = [&]() {
+        std::vector<int> clients(params.nbClients);
+        std::iota(clients.begin(), clients.end(), 1);
+        std::shuffle(clients.begin(), clients.end(), rng);
+
+        std::vector<std::vector<int>> routes;
+        for (size_t idx = 0; idx < clients.size(); idx += 20)
+        {
+            auto const end = std::min(idx + 20, clients.size());
+            routes.emplace_back(clients.begin() + idx, clients.begin() + end);
+        }
+
+        return Individual(&params, routes);
+    };
+
+    auto const indiv = randomIndividual();
+    std::vector<Individual> pop;
+    for (size_t idx = 0; idx != popSize; ++idx)
+        pop.push_back(randomIndividual());
+
+    std::vector<int> dists(popSize);
+    long checksum = 0;
+
+    auto const serial = timePerUpdate(nbUpdates, [&]() {
+        for (size_t idx = 0; idx != popSize; ++idx)
+            dists[idx] = indiv.brokenPairsDistance(&pop[idx]);
+
+        checksum += dists.back();
+    });
+
+    TaskScheduler::setSharedThreads(nbThreads);
+    auto const scheduler = TaskScheduler::shared();
+    auto const nbChunks = std::min(scheduler->numThreads(), popSize);
+
+    auto const parallel = timePerUpdate(nbUpdates, [&]() {
+        scheduler->parallelFor(nbChunks, [&](size_t chunk) {
+            for (auto idx = chunk; idx < popSize; idx += nbChunks)
+                dists[idx] = indiv.brokenPairsDistance(&pop[idx]);
+        });
+
+        checksum += dists.back();
+    });
+
+    std::cout << "n = " << params.nbClients << ", population " << popSize
+              << ": " << serial << " us serial, " << parallel << " us on "
+              << nbThreads << " threads (checksum " << checksum << ")\n";
+}
@@ -0,0 +1,98 @@
+// Measures random read throughput of a square matrix, for plain and aligned
+// (huge page backed) storage, and for uint16_t and int entries. Usage:
+//
+//     benchMatrix <dimension> [<nbReads> [<seed>]]
+//
+// The read positions are drawn up front. Each configuration reads the same
+// positions, and is run three times; the best run is reported.
+
+#include "Matrix.h"
+#include "XorShift128.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Returns the number of reads per second of the positions in the given matrix.
+// The sum of the values read is added to the checksum.
+template <typename Mat>
+double readsPerSecond(Mat const &matrix,
+                      std::vector<std::pair<uint32_t, uint32_t>> const &reads,
+                      long &checksum)
+{
+    auto best = 0.0;
+
+    for (int run = 0; run != 3; ++run)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        long sum = 0;
+
+        for (auto const &[row, col] : reads)
+            sum += matrix(row, col);
+
+        std::chrono::duration<double> const elapsed
+            = std::chrono::steady_clock::now() - start;
+
+        checksum += sum;
+        best = std::max(best, reads.size() / elapsed.count());
+    }
+
+    return best;
+}
+
+template <typename T>
+void run(std::string const &name,
+         size_t dimension,
+         std::vector<std::pair<uint32_t, uint32_t>> const &reads)
+{
+    Matrix<T> plain(dimension);
+    AlignedMatrix<T> aligned(dimension);
+
+    for (size_t row = 0; row != dimension; ++row)
+        for (size_t col = 0; col != dimension; ++col)
+        {
+            plain(row, col) = static_cast<T>(row + col);
+            aligned(row, col) = static_cast<T>(row + col);
+        }
+
+    long checksum = 0;
+    auto const plainReads = readsPerSecond(plain, reads, checksum);
+    auto const alignedReads = readsPerSecond(aligned, reads, checksum);
+
+    std::cout << name << ": " << plainReads / 1e6 << " M/s plain, "
+              << alignedReads / 1e6 << " M/s aligned (checksum " << checksum
+              << ")\n";
+}
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0]
+                  << " <dimension> [<nbReads> [<seed>]]\n";
+        return EXIT_FAILURE;
+    }
+
+    auto const dimension = static_cast<size_t>(std::atoi(argv[1]));
+    auto const nbReads = argc > 2 ? std::atoi(argv[2]) : 50'000'000;
+    auto const seed = argc > 3 ? std::atoi(argv[3]) : 1;
+
+    XorShift128 rng(seed);
+    std::vector<std::pair<uint32_t, uint32_t>> reads(nbReads);
+
+    for (auto &[row, col] : reads)
+    {
+        row = rng.randint(dimension);
+        col = rng.randint(dimension);
+    }
+
+    run<uint16_t>("uint16_t", dimension, reads);
+    run<int>("int", dimension, reads);
+}
@@ -0,0 +1,145 @@
+// Measures the evaluation throughput of the local search operators, on a
+// locally optimal solution of the given instance. Usage:
+//
+//     benchOperators <instance> [<seed> [<seconds>]]
+//
+// A random solution is first improved by the local search, using the same
+// operators as genvrp. Then the node operators are evaluated on all client
+// and neighbour pairs, and the route operators on all pairs of non-empty
+// routes, repeatedly, for about the given number of seconds each.
+
+#include "BenchSolution.h"
+#include "CostEvaluator.h"
+#include "Exchange.h"
+#include "Individual.h"
+#include "LocalSearch.h"
+#include "MoveTwoClientsReversed.h"
+#include "Params.h"
+#include "RelocateStar.h"
+#include "SwapStar.h"
+#include "TwoOpt.h"
+#include "XorShift128.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+// Calls pass() until the given duration has elapsed, and returns the number
+// of evaluations per second. Each call to pass() returns its number of
+// evaluations.
+template <typename Pass> double throughput(double seconds, Pass pass)
+{
+    using clock = std::chrono::steady_clock;
+
+    auto const start = clock::now();
+    std::chrono::duration<double> elapsed{};
+    size_t nbEvals = 0;
+
+    while (elapsed.count() < seconds)
+    {
+        nbEvals += pass();
+        elapsed = clock::now() - start;
+    }
+
+    return nbEvals / elapsed.count();
+}
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0]
+                  << " <instance> [<seed> [<seconds>]]\n";
+        return EXIT_FAILURE;
+    }
+
+    auto const seed = argc > 2 ? std::atoi(argv[2]) : 1;
+    auto const seconds = argc > 3 ? std::atof(argv[3]) : 2.0;
+
+    Config config;
+    XorShift128 rng(seed);
+    Params params(config, argv[1]);
+    CostEvaluator costEvaluator(params);
+    LocalSearch ls(params, rng);
+
+    Exchange<1, 0> exchange10(params);
+    Exchange<2, 0> exchange20(params);
+    MoveTwoClientsReversed reverse20(params);
+    Exchange<2, 2> exchange22(params);
+    Exchange<2, 1> exchange21(params);
+    Exchange<1, 1> exchange11(params);
+    TwoOpt twoOpt(params);
+    RelocateStar relocateStar(params);
+    SwapStar swapStar(params);
+
+    std::vector<LocalSearchOperator<Node> *> nodeOps = {&exchange10,
+                                                        &exchange20,
+                                                        &reverse20,
+                                                        &exchange22,
+                                                        &exchange21,
+                                                        &exchange11,
+                                                        &twoOpt};
+
+    std::vector<LocalSearchOperator<Route> *> routeOps = {&relocateStar,
+                                                          &swapStar};
+
+    for (auto *op : nodeOps)
+        ls.addNodeOperator(*op);
+
+    for (auto *op : routeOps)
+        ls.addRouteOperator(*op);
+
+    Individual indiv(&params, &rng);
+    ls.search(indiv, costEvaluator);
+    ls.intensify(indiv, costEvaluator);
+
+    BenchSolution sol(params, indiv);
+
+    for (auto *op : nodeOps)
+        op->init(indiv);
+
+    for (auto *op : routeOps)
+        op->init(indiv);
+
+    long checksum = 0;  // keeps the evaluations from being optimised away
+
+    auto const nodeRate = throughput(seconds, [&]() {
+        size_t nbEvals = 0;
+
+        for (int u = 1; u <= params.nbClients; ++u)
+            for (auto const v : params.getNeighboursOf(u))
+                for (auto *op : nodeOps)
+                {
+                    auto *U = &sol.clients[u];
+                    auto *V = &sol.clients[v];
+                    checksum += op->evaluate(U, V, costEvaluator);
+                    nbEvals++;
+                }
+
+        return nbEvals;
+    });
+
+    auto const routeRate = throughput(seconds, [&]() {
+        size_t nbEvals = 0;
+
+        for (size_t rU = 0; rU != indiv.numRoutes(); ++rU)
+            for (size_t rV = 0; rV != rU; ++rV)
+                for (auto *op : routeOps)
+                {
+                    auto *U = &sol.routes[rU];
+                    auto *V = &sol.routes[rV];
+                    checksum += op->evaluate(U, V, costEvaluator);
+                    nbEvals++;
+                }
+
+        return nbEvals;
+    });
+
+    std::cout << "node operators:  " << nodeRate / 1e6 << " M evaluations/s\n"
+              << "route operators: " << routeRate / 1e3
+              << " K evaluations/s\n"
+              << "checksum: " << checksum << '\n';
+}
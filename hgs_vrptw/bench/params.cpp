@@ -0,0 +1,84 @@
+// Times the construction of Params on random instances, which is dominated by
+// computing the granular neighbourhoods. Usage:
+//
+//     benchParams <nbClients> [<nbThreads> [<nbRepeats> [<seed>]]]
+//
+// Clients are placed uniformly at random on a 1000 x 1000 grid, and the
+// distance matrix holds the rounded Euclidean distances. The reported time
+// is the best of the repeats, and includes copying the distance matrix.
+
+#include "Config.h"
+#include "Params.h"
+#include "TaskScheduler.h"
+#include "XorShift128.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0]
+                  << " <nbClients> [<nbThreads> [<nbRepeats> [<seed>]]]\n";
+        return EXIT_FAILURE;
+    }
+
+    auto const nbClients = std::atoi(argv[1]);
+    auto const nbThreads = argc > 2 ? std::atoi(argv[2]) : 1;
+    auto const nbRepeats = argc > 3 ? std::atoi(argv[3]) : 3;
+    auto const seed = argc > 4 ? std::atoi(argv[4]) : 1;
+
+    TaskScheduler::setSharedThreads(nbThreads);
+    XorShift128 rng(seed);
+
+    std::vector<std::pair<int, int>> coords;
+    for (int i = 0; i <= nbClients; ++i)
+        coords.emplace_back(rng.randint(1000), rng.randint(1000));
+
+    std::vector<std::vector<int>> distMat(nbClients + 1,
+                                          std::vector<int>(nbClients + 1));
+
+    for (int i = 0; i <= nbClients; ++i)
+        for (int j = 0; j <= nbClients; ++j)
+        {
+            auto const dx = coords[i].first - coords[j].first;
+            auto const dy = coords[i].second - coords[j].second;
+            distMat[i][j] = std::lround(std::hypot(dx, dy));
+        }
+
+    std::vector<int> demands(nbClients + 1, 1);
+    std::vector<std::pair<int, int>> timeWindows(nbClients + 1, {0, 100'000});
+    std::vector<int> servDurs(nbClients + 1, 10);
+    std::vector<int> releases(nbClients + 1, 0);
+
+    demands[0] = 0;
+    servDurs[0] = 0;
+
+    Config config;
+    auto best = std::numeric_limits<double>::max();
+
+    for (int repeat = 0; repeat != nbRepeats; ++repeat)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        Params params(config,
+                      coords,
+                      demands,
+                      nbClients,
+                      timeWindows,
+                      servDurs,
+                      distMat,
+                      releases);
+        std::chrono::duration<double, std::milli> const elapsed
+            = std::chrono::steady_clock::now() - start;
+
+        best = std::min(best, elapsed.count());
+    }
+
+    std::cout << "n = " << nbClients << ": " << best << " ms\n";
+}
@@ -0,0 +1,143 @@
+// Times Route::update() after single-client relocates, optionally followed by
+// time window queries on the updated routes. Usage:
+//
+//     benchRoute <instance> <routeLength> [<nbMoves> [<nbQueries> [<seed>]]]
+//
+// The clients are shuffled, and split into routes of the given length. Each
+// move relocates a random client to a random position in a random route, and
+// then updates the affected routes. The target route is drawn uniformly, so
+// the route lengths vary over time, but stay around the given length. After
+// each move, each updated route gets nbQueries twBetween and nbQueries
+// twBetweenReversed queries on random segments.
+
+#include "BenchSolution.h"
+#include "Config.h"
+#include "Individual.h"
+#include "Params.h"
+#include "XorShift128.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        std::cerr << "Usage: " << argv[0]
+                  << " <instance> <routeLength> [<nbMoves> [<nbQueries>"
+                  << " [<seed>]]]\n";
+        return EXIT_FAILURE;
+    }
+
+    auto const routeLength = std::max(std::atoi(argv[2]), 1);
+    auto const nbMoves = argc > 3 ? std::atoi(argv[3]) : 200'000;
+    auto const nbQueries = argc > 4 ? std::atoi(argv[4]) : 0;
+    auto const seed = argc > 5 ? std::atoi(argv[5]) : 1;
+
+    Config config;
+    XorShift128 rng(seed);
+    Params params(config, argv[1]);
+
+    std::vector<int> clients(params.nbClients);
+    std::iota(clients.begin(), clients.end(), 1);
+    std::shuffle(clients.begin(), clients.end(), rng);
+
+    std::vector<std::vector<int>> routes;
+    for (size_t idx = 0; idx < clients.size(); idx += routeLength)
+    {
+        auto const end = std::min(idx + routeLength, clients.size());
+        routes.emplace_back(clients.begin() + idx, clients.begin() + end);
+    }
+
+    Individual indiv(&params, routes);
+    BenchSolution sol(params, indiv);
+
+    // The moves are drawn up front, so that drawing them is not timed. Each
+    // move is a client, a target route, and a number that determines the
+    // position in the target route.
+    struct Move
+    {
+        int client;
+        size_t route;
+        size_t position;
+    };
+
+    std::vector<Move> moves;
+    for (int move = 0; move != nbMoves; ++move)
+        moves.push_back({static_cast<int>(rng.randint(params.nbClients)) + 1,
+                         rng.randint(routes.size()),
+                         rng()});
+
+    // The query segments depend on the route sizes at the time of the query,
+    // so they are drawn from a (cycled) pool of random numbers instead.
+    std::vector<size_t> pool(4096);
+    for (auto &number : pool)
+        number = rng();
+
+    size_t poolIdx = 0;
+    auto const draw = [&](size_t bound) {
+        poolIdx = (poolIdx + 1) % pool.size();
+        return pool[poolIdx] % bound;
+    };
+
+    auto const query = [&](Route const *route) {
+        int sum = 0;
+
+        for (int count = 0; count != nbQueries; ++count)
+        {
+            auto start = draw(route->size() + 2);
+            auto end = draw(route->size() + 2);
+
+            if (start > end)
+                std::swap(start, end);
+
+            sum += route->twBetween(start, end).totalTimeWarp();
+            sum += route->twBetweenReversed(start, end).totalTimeWarp();
+        }
+
+        return sum;
+    };
+
+    size_t nbUpdates = 0;
+    long checksum = 0;
+    auto const start = std::chrono::steady_clock::now();
+
+    for (auto const &move : moves)
+    {
+        auto *U = &sol.clients[move.client];
+        auto const &route = sol.routes[move.route];
+        auto *V = route[move.position % (route.size() + 1)];
+
+        if (U == V || p(U) == V)
+            continue;
+
+        auto *routeU = U->route;
+        U->insertAfter(V);
+
+        routeU->update();
+        nbUpdates++;
+
+        if (V->route != routeU)
+        {
+            V->route->update();
+            nbUpdates++;
+            checksum += query(V->route);
+        }
+
+        checksum += query(routeU);
+    }
+
+    std::chrono::duration<double, std::nano> const elapsed
+        = std::chrono::steady_clock::now() - start;
+
+    std::cout << "average route size: " << params.nbClients / routes.size()
+              << '\n'
+              << "ns per move: " << elapsed.count() / moves.size() << '\n'
+              << "updates per move: " << double(nbUpdates) / moves.size()
+              << '\n'
+              << "checksum: " << checksum << '\n';
+}
@@ -0,0 +1,64 @@
+#ifndef ALIGNEDALLOCATOR_H
+#define ALIGNEDALLOCATOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+// Allocator that aligns storage to a cache line (64 bytes). Allocations of at
+// least one huge page (2MB) are instead aligned to a huge page boundary, and,
+// on Linux, marked as eligible for transparent huge pages. Large matrices that
+// are accessed at random (like the distance matrix) then need far fewer TLB
+// entries. Whether huge pages are actually used depends on the system's
+// transparent huge page setting; otherwise, regular pages are used.
+template <typename T> class AlignedAllocator
+{
+public:
+    using value_type = T;
+
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+    static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    AlignedAllocator() = default;
+
+    template <typename U>
+    AlignedAllocator(AlignedAllocator<U> const &) noexcept
+    {
+    }
+
+    [[nodiscard]] T *allocate(size_t n)
+    {
+        auto const bytes = std::max<size_t>(n * sizeof(T), 1);
+        auto const alignment
+            = bytes >= HUGE_PAGE_SIZE ? HUGE_PAGE_SIZE : CACHE_LINE_SIZE;
+
+        // aligned_alloc requires the size to be a multiple of the alignment.
+        auto const size = (bytes + alignment - 1) / alignment * alignment;
+        auto *ptr = std::aligned_alloc(alignment, size);
+
+        if (!ptr)
+            throw std::bad_alloc();
+
+#ifdef MADV_HUGEPAGE
+        if (alignment == HUGE_PAGE_SIZE)  // this is just a hint, so we do not
+            madvise(ptr, size, MADV_HUGEPAGE);  // care if it fails.
+#endif
+
+        return static_cast<T *>(ptr);
+    }
+
+    void deallocate(T *ptr, size_t n) noexcept { std::free(ptr); }
+
+    template <typename U>
+    bool operator==(AlignedAllocator<U> const &other) const noexcept
+    {
+        return true;
+    }
+};
+
+#endif  // ALIGNEDALLOCATOR_H
@@ -0,0 +1,75 @@
+#ifndef CIRCLESECTOR_H
+#define CIRCLESECTOR_H
+
+#include <cmath>
+#include <numbers>
+
+// Sector of the circle around the depot, covering the polar angles of a set of
+// clients. Angles are integers in [0, 65536), which represent [0, 2pi). The
+// sector runs counter-clockwise from its start angle to its end angle.
+class CircleSector
+{
+    static constexpr int NB_ANGLES = 65'536;
+
+    bool empty_ = true;  // Does the sector not cover any angle yet?
+    int start = 0;       // First angle of the sector
+    int end = 0;         // Last angle of the sector
+
+    [[nodiscard]] static int positiveMod(int angle)
+    {
+        return (angle % NB_ANGLES + NB_ANGLES) % NB_ANGLES;
+    }
+
+public:
+    /**
+     * Returns the polar angle of the given offset from the depot.
+     */
+    [[nodiscard]] static int polarAngle(int dx, int dy)
+    {
+        auto const angle
+            = NB_ANGLES / 2 * std::atan2(dy, dx) / std::numbers::pi;
+        return positiveMod(static_cast<int>(angle));
+    }
+
+    [[nodiscard]] bool empty() const { return empty_; }
+
+    /**
+     * Returns true when the given angle is within this sector.
+     */
+    [[nodiscard]] bool contains(int angle) const
+    {
+        return !empty_
+               && positiveMod(angle - start) <= positiveMod(end - start);
+    }
+
+    /**
+     * Extends this sector to contain the given angle. The sector is extended
+     * on whichever side results in the smallest sector.
+     */
+    void extend(int angle)
+    {
+        if (empty_)
+        {
+            empty_ = false;
+            start = angle;
+            end = angle;
+        }
+        else if (!contains(angle))
+        {
+            if (positiveMod(angle - end) <= positiveMod(start - angle))
+                end = angle;
+            else
+                start = angle;
+        }
+    }
+
+    /**
+     * Returns true when this sector and the other sector share an angle.
+     */
+    [[nodiscard]] bool overlaps(CircleSector const &other) const
+    {
+        return other.contains(start) || contains(other.start);
+    }
+};
+
+#endif  // CIRCLESECTOR_H
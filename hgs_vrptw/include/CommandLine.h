@@ -76,6 +76,21 @@ public:
                     = static_cast<size_t>(atoi(argv[i + 1]));
             else if (std::string(argv[i]) == "-repairBooster")
                 config.repairBooster = static_cast<size_t>(atoi(argv[i + 1]));
+            else if (std::string(argv[i]) == "-nbIslands")
+                config.nbIslands = static_cast<size_t>(atoi(argv[i + 1]));
+            else if (std::string(argv[i]) == "-migrationInterval")
+                config.migrationInterval
+                    = static_cast<size_t>(atoi(argv[i + 1]));
+            else if (std::string(argv[i]) == "-batchSize")
+                config.batchSize = static_cast<size_t>(atoi(argv[i + 1]));
+            else if (std::string(argv[i]) == "-nbThreads")
+                config.nbThreads = static_cast<size_t>(atoi(argv[i + 1]));
+            else if (std::string(argv[i]) == "-parallelIntensify")
+                config.parallelIntensify = atoi(argv[i + 1]) != 0;
+            else if (std::string(argv[i]) == "-renumberClients")
+                config.renumberClients = atoi(argv[i + 1]) != 0;
+            else if (std::string(argv[i]) == "-circleSectorFilter")
+                config.circleSectorFilter = atoi(argv[i + 1]) != 0;
         }
 
         return config;
@@ -49,6 +49,32 @@ struct Config
     // Number of nodes we improve by enumeration in LS postprocessing
     size_t postProcessPathLength = 7;
 
+    size_t nbIslands = 1;           // # independent populations
+    size_t migrationInterval = 50;  // migrate elites every # iterations
+
+    // # offspring generated (and educated in parallel) per step. Iterations
+    // are counted per offspring, so nbIter and nbPenaltyManagement do not
+    // depend on the batch size. Stopping criteria are evaluated per step.
+    size_t batchSize = 1;
+
+    // # threads of the shared task scheduler. genvrp sets up the scheduler
+    // with this many threads before solving; from Python, the scheduler is
+    // set up with hgspy.set_num_threads instead.
+    size_t nbThreads = 1;
+
+    // Evaluate route pairs in parallel, in rounds, during intensification?
+    bool parallelIntensify = false;
+
+    // Renumber the clients along a space-filling curve of their coordinates,
+    // so that nearby clients have nearby indices? This improves memory
+    // locality, but changes the search trajectory.
+    bool renumberClients = false;
+
+    // Only apply the route operators to route pairs whose circle sectors
+    // overlap during intensification? By default all pairs are evaluated,
+    // since skipping pairs gives worse solutions in the same time.
+    bool circleSectorFilter = false;
+
     explicit Config(int seed = 0,
                     size_t nbIter = 10'000,
                     int timeLimit = INT_MAX,
@@ -74,7 +100,14 @@ struct Config
                     int weightWaitTime = 18,
                     int weightTimeWarp = 20,
                     bool shouldIntensify = true,
-                    size_t postProcessPathLength = 7)
+                    size_t postProcessPathLength = 7,
+                    size_t nbIslands = 1,
+                    size_t migrationInterval = 50,
+                    size_t batchSize = 1,
+                    size_t nbThreads = 1,
+                    bool parallelIntensify = false,
+                    bool renumberClients = false,
+                    bool circleSectorFilter = false)
         : seed(seed),
           nbIter(nbIter),
           timeLimit(timeLimit),
@@ -100,7 +133,14 @@ struct Config
           weightWaitTime(weightWaitTime),
           weightTimeWarp(weightTimeWarp),
           shouldIntensify(shouldIntensify),
-          postProcessPathLength(postProcessPathLength)
+          postProcessPathLength(postProcessPathLength),
+          nbIslands(nbIslands),
+          migrationInterval(migrationInterval),
+          batchSize(batchSize),
+          nbThreads(nbThreads),
+          parallelIntensify(parallelIntensify),
+          renumberClients(renumberClients),
+          circleSectorFilter(circleSectorFilter)
     {
     }
 };
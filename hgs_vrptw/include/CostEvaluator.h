@@ -0,0 +1,65 @@
+#ifndef COSTEVALUATOR_H
+#define COSTEVALUATOR_H
+
+#include <algorithm>
+
+class Params;
+
+// Evaluates penalised costs of capacity and time window violations. Unlike the
+// instance data in Params, the penalty terms change during the search, so each
+// solver owns its own cost evaluator.
+class CostEvaluator
+{
+    int penaltyCapacity_;  // Excess capacity penalty (per unit)
+    int penaltyTimeWarp_;  // Time warp penalty (per unit)
+    int vehicleCapacity;   // Capacity limit
+
+public:
+    /**
+     * Computes the total excess capacity penalty for the given load.
+     */
+    [[nodiscard]] int loadPenalty(int load) const
+    {
+        return std::max(load - vehicleCapacity, 0) * penaltyCapacity_;
+    }
+
+    /**
+     * Computes the total time warp penalty for the give time warp.
+     */
+    [[nodiscard]] int twPenalty(int timeWarp) const
+    {
+        return timeWarp * penaltyTimeWarp_;
+    }
+
+    /**
+     * Returns the excess capacity penalty (per unit).
+     */
+    [[nodiscard]] int penaltyCapacity() const { return penaltyCapacity_; }
+
+    /**
+     * Returns the time warp penalty (per unit).
+     */
+    [[nodiscard]] int penaltyTimeWarp() const { return penaltyTimeWarp_; }
+
+    /**
+     * Constructs a cost evaluator with the given penalty terms.
+     *
+     * @param penaltyCapacity Excess capacity penalty (per unit).
+     * @param penaltyTimeWarp Time warp penalty (per unit).
+     * @param vehicleCapacity Vehicle capacity.
+     */
+    CostEvaluator(int penaltyCapacity, int penaltyTimeWarp, int vehicleCapacity)
+        : penaltyCapacity_(penaltyCapacity),
+          penaltyTimeWarp_(penaltyTimeWarp),
+          vehicleCapacity(vehicleCapacity)
+    {
+    }
+
+    /**
+     * Constructs a cost evaluator with reasonable initial penalty terms for
+     * the given instance.
+     */
+    explicit CostEvaluator(Params const &params);
+};
+
+#endif  // COSTEVALUATOR_H
@@ -0,0 +1,76 @@
+#ifndef DISTANCEMATRIX_H
+#define DISTANCEMATRIX_H
+
+#include "Matrix.h"
+
+#include <cstdint>
+
+// Square matrix of distances, stored in the narrowest integer type that holds
+// all distances: uint16_t when every distance is in [0, 65535], and int
+// otherwise. This halves the size of the matrix for most instances, so more
+// of it stays in cache during the search. Code that does many lookups should
+// use visit(), which tests the storage type once rather than on every lookup.
+// The storage is cache line aligned (with padded rows), and backed by huge
+// pages when it is large enough, since the distances are accessed at random.
+class DistanceMatrix
+{
+    size_t dimension_ = 0;  // number of rows (and columns)
+    bool isNarrow_ = false;
+    AlignedMatrix<uint16_t> narrow_;  // used when all distances fit 16 bits
+    AlignedMatrix<int> wide_;         // used otherwise
+
+public:
+    DistanceMatrix() = default;
+
+    /**
+     * Stores the given (square) matrix of distances.
+     */
+    explicit DistanceMatrix(Matrix<int> const &distances);
+
+    [[nodiscard]] int operator()(size_t row, size_t col) const
+    {
+        return isNarrow_ ? narrow_(row, col) : wide_(row, col);
+    }
+
+    /**
+     * Calls fn with the matrix that stores the distances: either an
+     * AlignedMatrix<uint16_t> or an AlignedMatrix<int>. Since fn is
+     * instantiated for each storage type, the lookups in fn do not need to
+     * test the storage type. Both instantiations must return the same type.
+     */
+    template <typename Fn> decltype(auto) visit(Fn &&fn) const
+    {
+        return isNarrow_ ? fn(narrow_) : fn(wide_);
+    }
+
+    /**
+     * Returns the number of bytes used to store each distance.
+     */
+    [[nodiscard]] size_t entryWidth() const
+    {
+        return isNarrow_ ? sizeof(uint16_t) : sizeof(int);
+    }
+
+    /**
+     * Returns the number of rows (and columns) of this matrix.
+     */
+    [[nodiscard]] size_t dimension() const { return dimension_; }
+};
+
+/**
+ * Returns the distance of the path first -> second -> ..., using the given
+ * matrix: a DistanceMatrix, or one of the matrices passed by its visit().
+ */
+template <typename DistMat, typename... Args>
+[[nodiscard]] int
+pathDist(DistMat const &distMat, size_t first, size_t second, Args... args)
+{
+    int const dist = distMat(first, second);
+
+    if constexpr (sizeof...(args) == 0)
+        return dist;
+    else
+        return dist + pathDist(distMat, second, args...);
+}
+
+#endif  // DISTANCEMATRIX_H
@@ -1,50 +1,123 @@
 #ifndef GENETIC_H
 #define GENETIC_H
 
+#include "CostEvaluator.h"
 #include "Individual.h"
 #include "LocalSearch.h"
 #include "Params.h"
 #include "Population.h"
 #include "Result.h"
+#include "Statistics.h"
 #include "StoppingCriterion.h"
 #include "XorShift128.h"
 
+#include <atomic>
 #include <functional>
+#include <memory>
 #include <unordered_set>
 #include <vector>
 
 // Class to run the genetic algorithm, which incorporates functionality of
-// population management, doing crossovers and updating parameters.
+// population management, doing crossovers and updating parameters. A genetic
+// algorithm object may only run on one thread at a time, and its population,
+// local search, and random number generator should not be used elsewhere
+// while it runs.
 class GeneticAlgorithm
 {
+public:
+    using Parents = std::pair<Individual const *, Individual const *>;
     using xOp = std::function<Individual(
-        std::pair<Individual const *, Individual const *> const &,
-        Params const &,
-        XorShift128 &)>;
+        Parents const &, Params const &, CostEvaluator const &, XorShift128 &)>;
+
+private:
+    // An independent population with its own penalty state, random number
+    // generator, and local search. All islands share the same parameters.
+    // Used in island mode.
+    struct Island;
+
+    // A copy of the local search with its own random number generator. Used
+    // by the tasks that educate offspring in batch mode: one for each
+    // offspring in a batch.
+    struct Worker
+    {
+        XorShift128 rng;
+        LocalSearch localSearch;
 
-    Params &params;    // Problem parameters
-    XorShift128 &rng;  // Random number generator
+        explicit Worker(LocalSearch const &other) : localSearch(other, rng) {}
+    };
+
+    Params const &params;  // Problem parameters
+    XorShift128 &rng;      // Random number generator
     Population &population;
     LocalSearch &localSearch;
 
+    CostEvaluator costEvaluator;  // current penalty terms
+
     std::vector<bool> loadFeas;  // load feasibility of recent individuals
     std::vector<bool> timeFeas;  // time feasibility of recent individuals
 
     std::vector<xOp> operators;  // crossover operators
 
+    std::vector<std::unique_ptr<Worker>> workers;  // used in batch mode
+
+    size_t iter = 0;             // number of iterations (offspring) performed
+    size_t nbIterNoImprove = 1;  // iterations since last improvement
+    Statistics stats;            // statistics collected during search
+
+    std::atomic<bool> inUse = false;  // is the algorithm currently running?
+
+    /**
+     * Performs a single iteration of the genetic algorithm: selects parents,
+     * generates and educates offspring, and manages the penalties. When
+     * ``batchSize > 1``, a batch of offspring is generated in each step. The
+     * iteration counters count offspring, so a batch of ``batchSize``
+     * offspring counts as ``batchSize`` iterations.
+     */
+    void step();
+
+    /**
+     * Generates and educates ``batchSize`` offspring. All parent pairs are
+     * selected first, after which the offspring are generated and educated
+     * in one task each, with their own local search and random number stream
+     * (split off from the main one). The results are added to the population
+     * in offspring order, so they do not depend on the number of threads.
+     */
+    void stepBatch();
+
+    /**
+     * Runs the genetic algorithm in island mode. The islands' iterations run
+     * concurrently on the shared scheduler, and every ``migrationInterval``
+     * iterations the best solution of each island migrates to the next
+     * island. Statistics are only collected for the first island (this
+     * object's population).
+     */
+    Result runIslands(StoppingCriterion &stop);
+
     /**
      * Runs the crossover algorithm: each given crossover operator is applied
-     * once, its resulting offspring inspected, and a geometric acceptance
-     * criterion is applied to select the offspring to return.
+     * once to the given parents, its resulting offspring inspected, and a
+     * geometric acceptance criterion is applied to select the offspring to
+     * return.
+     */
+    [[nodiscard]] Individual crossover(Parents const &parents,
+                                       XorShift128 &rng) const;
+
+    /**
+     * Performs local search on the given individual. If the individual is
+     * infeasible, with some probability we try to repair it. Returns the
+     * individuals that should be added to the population: the educated
+     * individual, and the repaired individual if the repair succeeded.
      */
-    [[nodiscard]] Individual crossover() const;
+    [[nodiscard]] std::vector<Individual> educate(Individual &indiv,
+                                                  LocalSearch &ls,
+                                                  XorShift128 &rng,
+                                                  Individual const &best) const;
 
     /**
-     * Performs local search and adds the individual to the population. If the
-     * individual is infeasible, with some probability we try to repair it and
-     * add it if this succeeds.
+     * Adds the given individual to the population, and registers its
+     * feasibility for penalty management.
      */
-    void educate(Individual &indiv);
+    void addIndividual(Individual const &indiv);
 
     /**
      * Updates the infeasibility penalties, based on the feasibility status of
@@ -59,7 +132,9 @@ public:
     void addCrossoverOperator(xOp const &op) { operators.push_back(op); }
 
     /**
-     * Runs the genetic algorithm with the given stopping criterion.
+     * Runs the genetic algorithm with the given stopping criterion. When
+     * ``nbIslands > 1``, this runs in island mode, and the stopping criterion
+     * is evaluated once per round of iterations (one iteration per island).
      *
      * @param stop The stopping criterion to use.
      * @return     Result object containing the best solution, and some optional
@@ -67,7 +142,7 @@ public:
      */
     Result run(StoppingCriterion &stop);
 
-    GeneticAlgorithm(Params &params,
+    GeneticAlgorithm(Params const &params,
                      XorShift128 &rng,
                      Population &population,
                      LocalSearch &localSearch);
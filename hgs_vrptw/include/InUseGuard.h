@@ -0,0 +1,31 @@
+#ifndef INUSEGUARD_H
+#define INUSEGUARD_H
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+
+/**
+ * Marks an object as in use for the lifetime of the guard. Objects that are
+ * not safe to use from multiple threads at the same time use this guard to
+ * detect concurrent use, and raise an exception when that happens.
+ */
+class InUseGuard
+{
+    std::atomic<bool> &inUse;
+
+public:
+    InUseGuard(std::atomic<bool> &inUse, std::string const &name)
+        : inUse(inUse)
+    {
+        if (inUse.exchange(true))
+            throw std::runtime_error(name + " cannot be used concurrently.");
+    }
+
+    InUseGuard(InUseGuard const &) = delete;
+    InUseGuard &operator=(InUseGuard const &) = delete;
+
+    ~InUseGuard() { inUse = false; }
+};
+
+#endif  // INUSEGUARD_H
@@ -1,6 +1,7 @@
 #ifndef INDIVIDUAL_H
 #define INDIVIDUAL_H
 
+#include "CostEvaluator.h"
 #include "Params.h"
 #include "XorShift128.h"
 
@@ -10,29 +11,91 @@
 // Object to represent one individual of a population.
 class Individual
 {
+public:
     using Client = int;
-    using Route = std::vector<Client>;
-    using Routes = std::vector<Route>;
+
+    /**
+     * Read-only view of the clients of one route, in visiting order.
+     */
+    class RouteView
+    {
+        Client const *first;
+        Client const *last;
+
+    public:
+        RouteView(Client const *first, Client const *last)
+            : first(first), last(last)
+        {
+        }
+
+        [[nodiscard]] Client const *begin() const { return first; }
+        [[nodiscard]] Client const *end() const { return last; }
+        [[nodiscard]] size_t size() const { return last - first; }
+        [[nodiscard]] bool empty() const { return first == last; }
+        [[nodiscard]] Client back() const { return *(last - 1); }
+
+        [[nodiscard]] Client operator[](size_t idx) const { return first[idx]; }
+    };
+
+    /**
+     * Read-only view of all routes of an individual, one for each vehicle.
+     * The non-empty routes come first; all routes from numRoutes() onwards
+     * are empty.
+     */
+    class RoutesView
+    {
+        Client const *clients;
+        size_t const *offsets;
+        size_t nbRoutes;
+        size_t nbVehicles;
+
+    public:
+        RoutesView(Client const *clients,
+                   size_t const *offsets,
+                   size_t nbRoutes,
+                   size_t nbVehicles)
+            : clients(clients),
+              offsets(offsets),
+              nbRoutes(nbRoutes),
+              nbVehicles(nbVehicles)
+        {
+        }
+
+        [[nodiscard]] size_t size() const { return nbVehicles; }
+
+        [[nodiscard]] RouteView operator[](size_t idx) const
+        {
+            if (idx >= nbRoutes)
+                return {clients, clients};
+
+            return {clients + offsets[idx], clients + offsets[idx + 1]};
+        }
+    };
+
+private:
+    using Routes = std::vector<std::vector<Client>>;
 
     size_t nbRoutes = 0;        // Number of routes
-    size_t distance = 0;        // Total distance
+    size_t distance_ = 0;       // Total distance
     size_t capacityExcess = 0;  // Total excess load over all routes
     size_t timeWarp = 0;        // All route time warp of late arrivals
 
-    // The other individuals in the population (cannot be the depot 0), ordered
-    // by increasing proximity.
-    std::vector<std::pair<int, Individual *>> indivsByProximity;
-
     Params const *params;  // Problem parameters
 
-    // For each vehicle, the associated sequence of deliveries (complete
-    // solution). Size is nbVehicles, but quite a few routes are likely empty
-    // - the numRoutes() member indicates the number of nonempty routes.
-    Routes routes_;
+    // The clients of all non-empty routes, stored back to back (complete
+    // solution). Route r consists of the clients in [offsets[r],
+    // offsets[r + 1]), so offsets has numRoutes() + 1 elements. This keeps
+    // individuals cheap to create, copy and destroy.
+    std::vector<Client> clients_;
+    std::vector<size_t> offsets_;
 
     // Pairs of [predecessor, successor] for each client (index)
     std::vector<std::pair<Client, Client>> neighbours;
 
+    // Removes empty routes from the offsets, and determines the neighbours
+    // and costs of this solution.
+    void setup();
+
     // Determines (pred, succ) pairs for each client
     void makeNeighbours();
 
@@ -41,17 +104,26 @@ class Individual
 
 public:
     /**
-     * Returns this individual's objective (penalized cost).
+     * Returns this individual's objective (penalized cost), using the penalty
+     * terms of the given cost evaluator.
      */
-    [[nodiscard]] size_t cost() const
+    [[nodiscard]] size_t cost(CostEvaluator const &costEvaluator) const
     {
+        auto const load = params->vehicleCapacity + capacityExcess;
+
         // clang-format off
-        return distance
-             + params->loadPenalty(params->vehicleCapacity + capacityExcess)
-             + params->twPenalty(timeWarp);
+        return distance_
+             + costEvaluator.loadPenalty(static_cast<int>(load))
+             + costEvaluator.twPenalty(static_cast<int>(timeWarp));
         // clang-format on
     }
 
+    /**
+     * Returns the total distance of this individual's routes. For feasible
+     * individuals, this is equal to the penalized cost.
+     */
+    [[nodiscard]] size_t distance() const { return distance_; }
+
     /**
      * Returns the number of non-empty routes in this individual's solution.
      * Such non-empty routes are all in the lower indices (guarantee) of the
@@ -62,7 +134,19 @@ public:
     /**
      * Returns this individual's routing decisions.
      */
-    [[nodiscard]] Routes const &getRoutes() const { return routes_; }
+    [[nodiscard]] RoutesView getRoutes() const
+    {
+        return {clients_.data(),
+                offsets_.data(),
+                nbRoutes,
+                static_cast<size_t>(params->nbVehicles)};
+    }
+
+    /**
+     * Returns this individual's routing decisions, in terms of the client
+     * indices of the instance data (see Params::originalId()).
+     */
+    [[nodiscard]] Routes getOriginalRoutes() const;
 
     /**
      * Returns a vector of [pred, succ] clients for each client (index) in this
@@ -74,6 +158,13 @@ public:
         return neighbours;
     }
 
+    /**
+     * Returns the [pred, succ] clients for each client, in terms of the client
+     * indices of the instance data (see Params::originalId()).
+     */
+    [[nodiscard]] std::vector<std::pair<Client, Client>>
+    getOriginalNeighbours() const;
+
     /**
      * Returns true when this solution is feasible; false otherwise.
      */
@@ -92,52 +183,40 @@ public:
      */
     [[nodiscard]] bool hasTimeWarp() const { return timeWarp > 0; }
 
-    /**
-     * Returns true when there exists another, identical individual.
-     */
-    [[nodiscard]] bool hasClone() const
-    {
-        return !indivsByProximity.empty()
-               && indivsByProximity.begin()->first == 0;
-    }
-
     // Computes and returns a distance measure with another individual, based
     // on the number of arcs that differ between two solutions.
     int brokenPairsDistance(Individual const *other) const;
 
-    // Updates the proximity structures of this and the other individual.
-    void registerNearbyIndividual(Individual *other);
-
-    // Returns the average distance of this individual to the individuals
-    // nearest to it.
-    [[nodiscard]] double avgBrokenPairsDistanceClosest() const;
-
-    // Exports a solution in CVRPLib format (adds a final line with the
-    // computational time).
-    void exportCVRPLibFormat(std::string const &path, double time) const;
-
-    bool operator<(Individual const &other) const
-    {
-        return cost() < other.cost();
-    }
+    // Exports a solution in CVRPLib format. The cost line gives the penalised
+    // cost under the given cost evaluator, and a final line is added with the
+    // computational time.
+    void exportCVRPLibFormat(std::string const &path,
+                             double time,
+                             CostEvaluator const &costEvaluator) const;
 
     bool operator==(Individual const &other) const
     {
-        return cost() == other.cost() && routes_ == other.routes_;
+        return distance_ == other.distance_ && clients_ == other.clients_
+               && offsets_ == other.offsets_;
     }
 
-    Individual &operator=(Individual const &other) = default;
-
     Individual(Params const *params, XorShift128 *rng);  // random individual
 
-    Individual(Params const *params, Routes routes);
-
-    Individual(Individual const &other);  // copy from other
+    Individual(Params const *params, Routes const &routes);
 
-    ~Individual();
+    /**
+     * Creates an individual from routes that are stored back to back in the
+     * given clients vector: route r consists of the clients in [offsets[r],
+     * offsets[r + 1]). Empty routes are allowed, and are removed.
+     */
+    Individual(Params const *params,
+               std::vector<Client> clients,
+               std::vector<size_t> offsets);
 };
 
-// Outputs an individual into a given ostream in CVRPLib format
+// Outputs the routes of an individual into a given ostream in CVRPLib format,
+// using the client indices of the instance data. The cost line depends on the
+// penalty terms, so it is written by exportCVRPLibFormat
 std::ostream &operator<<(std::ostream &out, Individual const &indiv);
 
 #endif
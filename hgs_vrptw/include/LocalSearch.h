@@ -1,6 +1,7 @@
 #ifndef LOCALSEARCH_H
 #define LOCALSEARCH_H
 
+#include "CostEvaluator.h"
 #include "Individual.h"
 #include "Node.h"
 #include "Params.h"
@@ -9,19 +10,35 @@
 
 #include "LocalSearchOperator.h"
 
+#include <atomic>
 #include <functional>
+#include <memory>
 #include <vector>
 
+// Local search around individuals. A local search object (and its operators)
+// may only be used by one thread at a time: this is checked by search() and
+// intensify(). Separate local search objects may share the same parameters.
 class LocalSearch
 {
     using NodeOp = LocalSearchOperator<Node>;
     using RouteOp = LocalSearchOperator<Route>;
 
-    Params &params;    // Problem parameters
-    XorShift128 &rng;  // Random number generator
+    // Partial subpath in the subpath enumeration: it starts at the node before
+    // the subpath, and visits the clients of a subset of the subpath.
+    struct SubpathLabel
+    {
+        int dist;               // Distance from the node before the subpath
+        TimeWindowSegment tws;  // TWS from the depot up to the last client
+        size_t last;            // Subpath index of the last client visited
+        size_t parent;          // Label this label extends (or itself)
+    };
+
+    Params const &params;  // Problem parameters
+    XorShift128 &rng;      // Random number generator
 
     std::vector<int> orderNodes;   // random node order used in RI operators
-    std::vector<int> orderRoutes;  // random route order used in SWAP* operators
+    std::vector<int> orderRoutes;  // random order of the active routes, used
+                                   // in SWAP* operators
 
     std::vector<int> lastModified;  // tracks when routes were last modified
 
@@ -30,33 +47,76 @@ class LocalSearch
     std::vector<Node> endDepots;    // These mark the end of routes
     std::vector<Route> routes;
 
+    // Route indices, split into two lists: the first nbActiveRoutes entries
+    // are the active (non-empty) routes, and the other entries are the free
+    // list of empty routes. routePositions[r] is the index of route r in
+    // routesByUse, so routes move between the lists in constant time. This
+    // keeps the work per move independent of the number of vehicles.
+    std::vector<int> routesByUse;
+    std::vector<size_t> routePositions;
+    size_t nbActiveRoutes = 0;
+
     std::vector<NodeOp *> nodeOps;
     std::vector<RouteOp *> routeOps;
 
+    // Operators owned by this local search. These are only used when this
+    // object is constructed as a copy of another local search.
+    std::vector<std::unique_ptr<NodeOp>> ownedNodeOps;
+    std::vector<std::unique_ptr<RouteOp>> ownedRouteOps;
+
     int nbMoves = 0;               // Operator counter
     bool searchCompleted = false;  // No further improving move found?
 
+    std::atomic<bool> inUse = false;  // is a search currently running?
+
+    // Scratch space for the subpath enumeration, re-used between calls. The
+    // labels of subset S ending at subpath index i are labelsByState[S * k +
+    // i], for subpaths of length k.
+    std::vector<SubpathLabel> labels;
+    std::vector<std::vector<size_t>> labelsByState;
+
     // Load an initial solution that we will attempt to improve
     void loadIndividual(Individual const &indiv);
 
     // Export the LS solution back into an individual
     Individual exportIndividual();
 
-    [[nodiscard]] bool applyNodeOps(Node *U, Node *V);
+    // Tests whether the route operators should be applied to routes U and V:
+    // that is, whether their circle sectors overlap (or the circle sector
+    // filter is disabled).
+    [[nodiscard]] bool sectorsOverlap(Route const &U, Route const &V) const;
 
-    [[nodiscard]] bool applyRouteOps(Route *U, Route *V);
+    [[nodiscard]] bool
+    applyNodeOps(Node *U, Node *V, CostEvaluator const &costEvaluator);
+
+    [[nodiscard]] bool
+    applyRouteOps(Route *U, Route *V, CostEvaluator const &costEvaluator);
 
     // Updates solution state after an improving local search move
     void update(Route *U, Route *V);
 
-    // Enumerates and optimally recombines subpaths of the given route
-    void enumerateSubpaths(Route &U);
+    // Moves the given route to the active or free list, depending on whether
+    // it is empty.
+    void updateActiveRoutes(Route const &route);
+
+    // Intensifies in rounds. Each round evaluates all changed route pairs in
+    // parallel, and then applies improving moves that touch disjoint routes.
+    void intensifyParallel(CostEvaluator const &costEvaluator);
+
+    // Optimally recombines subpaths of the given route. For each subpath,
+    // the best order of its clients is determined by dynamic programming over
+    // subsets of the clients (Held-Karp). Each subset and last client keeps
+    // the partial paths that are not dominated in distance and time window
+    // data, and partial paths that cannot improve the current order are
+    // pruned.
+    void enumerateSubpaths(Route &U, CostEvaluator const &costEvaluator);
 
     // Evaluates the path before -> <nodes in sub path> -> after
     inline int evaluateSubpath(std::vector<size_t> const &subpath,
                                Node const *before,
                                Node const *after,
-                               Route const &route) const;
+                               Route const &route,
+                               CostEvaluator const &costEvaluator) const;
 
 public:
     /**
@@ -66,22 +126,50 @@ public:
 
     /**
      * Adds a local search operator that works on route pairs U and V. These
-     * operators are executed for route pairs whose circle sectors overlap.
+     * operators are executed for all route pairs, or only for those whose
+     * circle sectors overlap when the config's ``circleSectorFilter`` is set.
      */
     void addRouteOperator(RouteOp &op) { routeOps.emplace_back(&op); }
 
     /**
-     * Performs regular (node-based) local search around the given individual.
+     * Returns the node operators used by this local search.
      */
-    void search(Individual &indiv);
+    [[nodiscard]] std::vector<NodeOp *> const &nodeOperators() const
+    {
+        return nodeOps;
+    }
+
+    /**
+     * Returns the route operators used by this local search.
+     */
+    [[nodiscard]] std::vector<RouteOp *> const &routeOperators() const
+    {
+        return routeOps;
+    }
+
+    /**
+     * Performs regular (node-based) local search around the given individual,
+     * using the penalty terms of the given cost evaluator.
+     */
+    void search(Individual &indiv, CostEvaluator const &costEvaluator);
 
     /**
      * Performs a more intensive local search around the given individual,
-     * using route-based operators and subpath enumeration.
+     * using route-based operators and subpath enumeration. When the config's
+     * ``parallelIntensify`` is set, route pairs are evaluated in parallel on
+     * the shared task scheduler.
      */
-    void intensify(Individual &indiv);
+    void intensify(Individual &indiv, CostEvaluator const &costEvaluator);
+
+    LocalSearch(Params const &params, XorShift128 &rng);
 
-    LocalSearch(Params &params, XorShift128 &rng);
+    /**
+     * Constructs a local search that uses the same parameters as the other
+     * local search, and copies of its operators. The copy has its own random
+     * number generator and operator state, so it can be used concurrently
+     * with the other local search.
+     */
+    LocalSearch(LocalSearch const &other, XorShift128 &rng);
 };
 
 #endif
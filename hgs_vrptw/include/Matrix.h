@@ -1,48 +1,104 @@
 #ifndef MATRIX_H
 #define MATRIX_H
 
+#include "AlignedAllocator.h"
+
 #include <algorithm>
+#include <memory>
+#include <numeric>
+#include <type_traits>
 #include <vector>
 
 // Implementation of a matrix in a C++ vector
 // This class is used because a flat vector is faster than a vector of vectors
 // which requires two lookup operations rather than one to index a matrix
-// element
-template <typename T> class Matrix
+// element. When the storage is allocated with an AlignedAllocator, each row is
+// padded so that every row starts at a cache line boundary.
+template <typename T, typename Allocator = std::allocator<T>> class Matrix
 {
-    size_t cols_;          // The number of columns of the matrix
-    std::vector<T> data_;  // The vector where all the data is stored (this
-                           // represents the matrix)
+    static constexpr bool isAligned
+        = std::is_same_v<Allocator, AlignedAllocator<T>>;
+
+    size_t rows_;                     // The number of rows of the matrix
+    size_t cols_;                     // The number of columns of the matrix
+    size_t stride_;                   // Distance between consecutive rows
+    std::vector<T, Allocator> data_;  // The vector where all the data is
+                                      // stored (this represents the matrix)
+
+    // Returns the (possibly padded) row length for the given number of columns
+    static size_t strideFor(size_t nCols)
+    {
+        if constexpr (!isAligned)
+            return nCols;
+        else
+        {
+            // Smallest number of elements that spans a whole number of cache
+            // lines.
+            auto constexpr lineSize = AlignedAllocator<T>::CACHE_LINE_SIZE;
+            auto constexpr unit = lineSize / std::gcd(lineSize, sizeof(T));
+            return (nCols + unit - 1) / unit * unit;
+        }
+    }
 
 public:
     // Empty constructor: with zero columns and a vector of size zero
-    Matrix() : cols_(0), data_(0) {}
+    Matrix() : rows_(0), cols_(0), stride_(0), data_(0) {}
 
     // Constructor: create a matrix of size dimension by dimension, using a C++
     // vector of size dimension * dimension.
-    explicit Matrix(size_t dimension)
-        : cols_(dimension), data_(dimension * dimension)
+    explicit Matrix(size_t dimension) : Matrix(dimension, dimension) {}
+
+    Matrix(size_t nRows, size_t nCols)
+        : rows_(nRows),
+          cols_(nCols),
+          stride_(strideFor(nCols)),
+          data_(nRows * stride_)
     {
     }
 
-    Matrix(size_t nRows, size_t nCols) : cols_(nCols), data_(nRows * nCols) {}
-
     [[nodiscard]] decltype(auto) operator()(size_t row, size_t col)
     {
-        return data_[cols_ * row + col];
+        return data_[stride_ * row + col];
     }
 
     [[nodiscard]] decltype(auto) operator()(size_t row, size_t col) const
     {
-        return data_[cols_ * row + col];
+        return data_[stride_ * row + col];
     }
 
     [[nodiscard]] T max() const
     {
-        return *std::max_element(data_.begin(), data_.end());
+        if constexpr (!isAligned)
+            return *std::max_element(data_.begin(), data_.end());
+        else
+        {
+            auto maximum = (*this)(0, 0);
+
+            for (size_t row = 0; row != rows_; ++row)
+            {
+                auto const first = data_.begin() + stride_ * row;
+                maximum = std::max(maximum,
+                                   *std::max_element(first, first + cols_));
+            }
+
+            return maximum;
+        }
     }
 
-    [[nodiscard]] size_t size() const { return data_.size(); }
+    [[nodiscard]] size_t size() const { return rows_ * cols_; }
+
+    // Iterators over the underlying storage. This includes the row padding,
+    // if there is any.
+    [[nodiscard]] auto begin() const { return data_.begin(); }
+
+    [[nodiscard]] auto end() const { return data_.end(); }
+
+    [[nodiscard]] size_t numRows() const { return rows_; }
+
+    [[nodiscard]] size_t numCols() const { return cols_; }
 };
 
+// Matrix with cache line aligned rows, backed by huge pages when large enough.
+template <typename T> using AlignedMatrix = Matrix<T, AlignedAllocator<T>>;
+
 #endif
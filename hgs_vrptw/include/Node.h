@@ -1,6 +1,7 @@
 #ifndef NODE_H
 #define NODE_H
 
+#include "Params.h"
 #include "TimeWindowSegment.h"
 
 class Route;
@@ -16,16 +17,25 @@ public:  // TODO make fields private
     Node *prev;       // Previous node in the route order
     Route *route;     // Pointer towards the associated route
 
-    int cumulatedLoad;              // Load from depot to client (inclusive)
-    int cumulatedDistance;          // Distance from depot to client (inclusive)
-    int cumulatedReversalDistance;  // Distance if (0 .. client) is reversed
-
-    TimeWindowSegment tw;        // TWS for individual node (client)
-    TimeWindowSegment twBefore;  // TWS for (0...client) including self
-    TimeWindowSegment twAfter;   // TWS for (client...0) including self
+    TimeWindowSegment tw;  // TWS for individual node (client)
 
     [[nodiscard]] bool isDepot() const { return client == 0; }
 
+    // The following cumulative data is stored by the node's route, at the
+    // node's position. These members are defined in Route.h.
+
+    // Load from depot to client (inclusive)
+    [[nodiscard]] inline int cumulatedLoad() const;
+
+    // Distance if (0 .. client) is reversed
+    [[nodiscard]] inline int cumulatedReversalDistance() const;
+
+    // TWS for (0...client) including self
+    [[nodiscard]] inline TimeWindowSegment const &twBefore() const;
+
+    // TWS for (client...0) including self
+    [[nodiscard]] inline TimeWindowSegment const &twAfter() const;
+
     /**
      * Inserts this node after the other and updates the solution.
      */
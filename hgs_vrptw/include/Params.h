@@ -2,14 +2,16 @@
 #define PARAMS_H
 
 #include "Config.h"
-#include "Matrix.h"
+#include "DistanceMatrix.h"
 #include "XorShift128.h"
 
 #include <iosfwd>
 #include <vector>
 
 // Class that stores all the parameters (from the command line) (in Config) and
-// data of the instance needed by the algorithm
+// data of the instance needed by the algorithm. This data does not change once
+// constructed, so a single Params object can be shared by any number of
+// solvers (and threads). The penalty terms are in CostEvaluator.
 class Params
 {
     struct Client
@@ -24,89 +26,152 @@ class Params
                           // this time
     };
 
-    // Penalty booster that increases the penalty on capacity and time window
-    // violations during the object's lifetime.
-    struct PenaltyBooster
-    {
-        Params *d_params;
-
-        explicit PenaltyBooster(Params *params) : d_params(params)
-        {
-            d_params->penaltyCapacity *= d_params->config.repairBooster;
-            d_params->penaltyTimeWarp *= d_params->config.repairBooster;
-        }
-
-        ~PenaltyBooster()
-        {
-            d_params->penaltyCapacity /= d_params->config.repairBooster;
-            d_params->penaltyTimeWarp /= d_params->config.repairBooster;
-        }
-    };
+    // Neighborhood restrictions: for each client, the nbNeighbours nearby
+    // clients, sorted by client index. These are stored contiguously, so the
+    // neighbours of client i (i > 0) start at index (i - 1) * nbNeighbours.
+    // Nothing is stored for the depot!
+    std::vector<int> neighbours;
+    size_t nbNeighbours = 0;
+
+    DistanceMatrix dist_;  // Distance matrix (+depot)
+    int maxDist_;          // Maximum distance in the distance matrix
+
+    // Maps client indices to the indices of the instance data, and back. These
+    // are identity maps unless the clients are renumbered.
+    std::vector<int> originalIds;
+    std::vector<int> internalIds;
+
+    // Client (+depot) data, stored per field. Hot loops typically read only
+    // one or two fields, so this touches less memory than the Client structs
+    // and lets the compiler vectorise loops over consecutive clients.
+    std::vector<int> xs_;
+    std::vector<int> ys_;
+    std::vector<int> servDurs_;
+    std::vector<int> demands_;
+    std::vector<int> twEarlies_;
+    std::vector<int> twLates_;
+    std::vector<int> releaseTimes_;
+    std::vector<int> angles_;  // Polar angle around the depot (CircleSector)
 
-    // Neighborhood restrictions: For each client, list of nearby clients (size
-    // nbClients + 1, but nothing stored for the depot!)
-    std::vector<std::vector<int>> neighbours;
+    /**
+     * Copies the client data into the per-field arrays, and computes the
+     * clients' polar angles. Must be called once the client data is final,
+     * that is, after renumbering.
+     */
+    void storeClientFields();
 
-    Matrix<int> dist_;  // Distance matrix (+depot)
-    int maxDist_;       // Maximum distance in the distance matrix
+    /**
+     * Sets up the client index maps. If the configuration asks for it, the
+     * clients (and the given distances) are renumbered in the order in which
+     * a Hilbert curve through their coordinates visits them, so nearby
+     * clients get nearby indices. The depot keeps index 0.
+     */
+    void renumberClients(Matrix<int> &distances);
 
     /**
      * Calculate, for all vertices, the correlation ('nearness') of the
-     * nbGranular closest vertices.
+     * nbGranular closest vertices. Clients are divided over the threads of
+     * the shared task scheduler.
      */
     void calculateNeighbours();
 
 public:
+    /**
+     * Read-only view of a contiguous range of clients.
+     */
+    class ClientRange
+    {
+        int const *first;
+        int const *last;
+
+    public:
+        ClientRange(int const *first, int const *last)
+            : first(first), last(last)
+        {
+        }
+
+        [[nodiscard]] int const *begin() const { return first; }
+        [[nodiscard]] int const *end() const { return last; }
+        [[nodiscard]] size_t size() const { return last - first; }
+    };
+
     // TODO make members private
 
     Config const config;  // Stores all the parameter values
 
-    int penaltyCapacity;  // Excess capacity penalty (per unit)
-    int penaltyTimeWarp;  // Time warp penalty (per unit)
-
     int nbClients;        // Number of clients (excluding the depot)
     int nbVehicles;       // Number of vehicles
     int vehicleCapacity;  // Capacity limit
 
     std::vector<Client> clients;  // Client (+depot) information
 
+    // Per-field access to the client (+depot) information. These return the
+    // same values as the corresponding fields in clients, but read from
+    // contiguous per-field arrays.
+    [[nodiscard]] int x(size_t client) const { return xs_[client]; }
+    [[nodiscard]] int y(size_t client) const { return ys_[client]; }
+    [[nodiscard]] int servDur(size_t client) const { return servDurs_[client]; }
+    [[nodiscard]] int demand(size_t client) const { return demands_[client]; }
+    [[nodiscard]] int twLate(size_t client) const { return twLates_[client]; }
+
+    [[nodiscard]] int twEarly(size_t client) const
+    {
+        return twEarlies_[client];
+    }
+
+    [[nodiscard]] int releaseTime(size_t client) const
+    {
+        return releaseTimes_[client];
+    }
+
     /**
-     * Computes the total excess capacity penalty for the given load.
+     * Returns the polar angle of the client around the depot, in the integer
+     * units used by CircleSector.
      */
-    [[nodiscard]] int loadPenalty(int load) const
+    [[nodiscard]] int angle(size_t client) const { return angles_[client]; }
+
+    /**
+     * Returns the nbGranular clients nearest/closest to the passed-in client,
+     * sorted by client index. The depot has no neighbours.
+     */
+    [[nodiscard]] ClientRange getNeighboursOf(size_t client) const
     {
-        return std::max(load - vehicleCapacity, 0) * penaltyCapacity;
+        if (client == 0)
+            return {nullptr, nullptr};
+
+        auto const *first = neighbours.data() + (client - 1) * nbNeighbours;
+        return {first, first + nbNeighbours};
     }
 
+    [[nodiscard]] int maxDist() const { return maxDist_; }
+
     /**
-     * Computes the total time warp penalty for the give time warp.
+     * Returns the index of the given client in the instance data. This
+     * differs from the client's index in the solver when the clients are
+     * renumbered.
      */
-    [[nodiscard]] int twPenalty(int timeWarp) const
+    [[nodiscard]] int originalId(int client) const
     {
-        return timeWarp * penaltyTimeWarp;
+        return originalIds[client];
     }
 
     /**
-     * Returns a penalty booster that temporarily increases infeasibility
-     * penalties (while the booster lives).
+     * Returns the index in the solver of the client with the given index in
+     * the instance data. This is the inverse of originalId().
      */
-    [[nodiscard]] PenaltyBooster getPenaltyBooster()
+    [[nodiscard]] int internalId(int client) const
     {
-        return PenaltyBooster(this);
+        return internalIds[client];
     }
 
     /**
-     * Returns the nbGranular clients nearest/closest to the passed-in client.
+     * Returns the distance matrix (including the depot).
      */
-    [[nodiscard]] std::vector<int> const &getNeighboursOf(size_t client) const
+    [[nodiscard]] DistanceMatrix const &distanceMatrix() const
     {
-        return neighbours[client];
+        return dist_;
     }
 
-    [[nodiscard]] int maxDist() const { return maxDist_; }
-
-    [[nodiscard]] int &dist(size_t row, size_t col) { return dist_(row, col); }
-
     [[nodiscard]] int dist(size_t row, size_t col) const
     {
         return dist_(row, col);
@@ -1,7 +1,9 @@
 #ifndef POPULATION_H
 #define POPULATION_H
 
+#include "CostEvaluator.h"
 #include "Individual.h"
+#include "Matrix.h"
 #include "Params.h"
 #include "Statistics.h"
 #include "XorShift128.h"
@@ -19,10 +21,12 @@ class Population
     {
         std::unique_ptr<Individual> indiv;
         double fitness;
+        size_t cost;  // penalized cost, as of the last insertion or re-order
+        size_t slot;  // row (and column) of this individual in distances
 
         bool operator<(IndividualWrapper const &other) const
         {
-            return indiv->cost() < other.indiv->cost();
+            return cost < other.cost;
         }
     };
 
@@ -32,56 +36,117 @@ public:
 private:
     using Parents = std::pair<Individual const *, Individual const *>;
 
-    Params &params;    // Problem parameters
-    XorShift128 &rng;  // Random number generator
+    Params const &params;  // Problem parameters
+    XorShift128 &rng;      // Random number generator
 
     SubPopulation feasible;    // Sub-population ordered asc. by cost
     SubPopulation infeasible;  // Sub-population ordered asc. by cost
 
     Individual bestSol;
 
+    // Individuals that were removed from the population. Their storage is
+    // re-used for new individuals, so adding individuals does not allocate
+    // once the population has reached its maximum size. (Unless the distance
+    // computations are large enough to be run as tasks; see addIndividual().)
+    std::vector<std::unique_ptr<Individual>> pool;
+
+    // Broken pairs distances between individuals in the same sub-population,
+    // indexed by slot. Each individual in the population occupies one slot;
+    // the slots of removed individuals are re-used. Entries between slots in
+    // different sub-populations (or unused slots) are meaningless.
+    Matrix<int> distances;
+    std::vector<size_t> freeSlots;
+
+    // Scratch space, re-used between calls to avoid allocations.
+    std::vector<int> dists;
+    std::vector<int> closest;
+    std::vector<std::pair<double, size_t>> diversity;
+
+    // Returns an unused slot in the distance matrix, growing the matrix if
+    // all slots are in use.
+    size_t acquireSlot();
+
+    // Returns the average broken pairs distance of the individual at the given
+    // position in the sub-population to the nbClose individuals nearest to it.
+    // The given vector is used as scratch space.
+    [[nodiscard]] double
+    avgBrokenPairsDistanceClosest(SubPopulation const &subPop,
+                                  size_t idx,
+                                  std::vector<int> &buffer) const;
+
+    // Returns true when there exists another individual in the sub-population
+    // that is identical to the individual at the given position.
+    [[nodiscard]] bool hasClone(SubPopulation const &subPop, size_t idx) const;
+
+    // Returns an individual with a copy of the given individual's routes,
+    // taken from the pool if possible.
+    std::unique_ptr<Individual> acquire(Individual const &indiv);
+
+    // Removes the individual at the given position in the sub-population, and
+    // returns it to the pool. Its slot becomes available for re-use.
+    void release(SubPopulation &subPop, SubPopulation::iterator pos);
+
     // Evaluates the biased fitness of all individuals in the sub-population
-    void updateBiasedFitness(SubPopulation &subPop) const;
+    void updateBiasedFitness(SubPopulation &subPop);
 
     // Removes a duplicate individual from the sub-population if there exists
     // one. If there are multiple duplicate individuals, then the one with the
     // lowest index in the sub-population is removed first.
-    static bool removeDuplicate(SubPopulation &subPop);
+    bool removeDuplicate(SubPopulation &subPop);
 
     // Removes the worst individual in terms of biased fitness
-    static void removeWorstBiasedFitness(SubPopulation &subPop);
+    void removeWorstBiasedFitness(SubPopulation &subPop);
 
     // Generates a population of passed-in size
-    void generatePopulation(size_t popSize);
+    void generatePopulation(size_t popSize, CostEvaluator const &costEvaluator);
 
-    // Selects an individual by binary tournament
-    Individual const *getBinaryTournament();
+    // Selects an individual by binary tournament, and returns its wrapper and
+    // the sub-population it belongs to.
+    std::pair<IndividualWrapper const *, SubPopulation const *>
+    getBinaryTournament();
 
 public:
     // Add an individual in the population. Survivor selection is automatically
-    // triggered whenever the population reaches its maximum size.
-    void addIndividual(Individual const &indiv);
+    // triggered whenever the population reaches its maximum size. The given
+    // cost evaluator is used to determine the individual's penalized cost.
+    void addIndividual(Individual const &indiv,
+                       CostEvaluator const &costEvaluator);
 
     // Cleans all solutions and generates a new initial population (only used
     // when running HGS until a time limit, in which case the algorithm restarts
     // until the time limit is reached)
-    void restart();
+    void restart(CostEvaluator const &costEvaluator);
 
     /**
-     * Re-orders the population by cost.
+     * Re-orders the population by cost, using the penalty terms of the given
+     * cost evaluator.
      */
-    void reorder()
+    void reorder(CostEvaluator const &costEvaluator)
     {
-        auto const op = [](auto const &wrapper1, auto const &wrapper2) {
-            return wrapper1.indiv->cost() < wrapper2.indiv->cost();
-        };
-        std::sort(feasible.begin(), feasible.end(), op);
-        std::sort(infeasible.begin(), infeasible.end(), op);
+        for (auto *subPop : {&feasible, &infeasible})
+        {
+            for (auto &wrapper : *subPop)
+                wrapper.cost = wrapper.indiv->cost(costEvaluator);
+
+            std::sort(subPop->begin(), subPop->end());
+        }
     }
 
     // Selects two (if possible non-identical) parents by binary tournament
     Parents selectParents();
 
+    /**
+     * Returns the average broken pairs distance of the individual at the given
+     * position in the given sub-population to the nbClose individuals in that
+     * sub-population that are nearest to it.
+     */
+    [[nodiscard]] double avgBrokenPairsDistanceClosest(
+        SubPopulation const &subPop, size_t idx) const
+    {
+        std::vector<int> buffer;
+        return avgBrokenPairsDistanceClosest(subPop, idx, buffer);
+    }
+
     /**
      * Returns the best feasible solution that was observed during iteration.
      */
@@ -93,10 +158,12 @@ public:
      */
     [[nodiscard]] size_t getCurrentBestFeasibleCost() const
     {
-        return !feasible.empty() ? feasible[0].indiv->cost() : INT_MAX;
+        return !feasible.empty() ? feasible[0].cost : INT_MAX;
     }
 
-    Population(Params &params, XorShift128 &rng);
+    Population(Params const &params,
+               XorShift128 &rng,
+               CostEvaluator const &costEvaluator);
 };
 
 #endif
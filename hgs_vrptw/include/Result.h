@@ -1,6 +1,7 @@
 #ifndef RESULT_H
 #define RESULT_H
 
+#include "CostEvaluator.h"
 #include "Individual.h"
 #include "Statistics.h"
 
@@ -10,19 +11,25 @@
 class Result
 {
     Individual const bestFound;
+    CostEvaluator const costEvaluator;  // penalty terms at the end of the run
     Statistics const stats;
     size_t numIters;
     double runTime;
+    std::vector<size_t> islandIters;
 
 public:
     Result(Individual const &bestFound,
+           CostEvaluator const &costEvaluator,
            Statistics stats,
            size_t numIters,
-           double runTime)
+           double runTime,
+           std::vector<size_t> islandIters = {})
         : bestFound(bestFound),
+          costEvaluator(costEvaluator),
           stats(std::move(stats)),
           numIters(numIters),
-          runTime(runTime)
+          runTime(runTime),
+          islandIters(std::move(islandIters))
     {
     }
 
@@ -31,6 +38,16 @@ public:
      */
     [[nodiscard]] Individual const &getBestFound() const { return bestFound; }
 
+    /**
+     * Returns the cost evaluator with the penalty terms the genetic algorithm
+     * used at the end of the run. The best solution's penalised cost is
+     * reported using these terms.
+     */
+    [[nodiscard]] CostEvaluator const &getCostEvaluator() const
+    {
+        return costEvaluator;
+    }
+
     /**
      * Returns statistics collected by the genetic algorithm.
      */
@@ -41,6 +58,15 @@ public:
      */
     [[nodiscard]] size_t getIterations() const { return numIters; }
 
+    /**
+     * Returns the number of iterations performed by each island. This is empty
+     * when the genetic algorithm did not run in island mode.
+     */
+    [[nodiscard]] std::vector<size_t> const &getIslandIterations() const
+    {
+        return islandIters;
+    }
+
     /**
      * Returns the total elapsed runtime in seconds.
      */
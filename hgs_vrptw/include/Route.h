@@ -1,6 +1,7 @@
 #ifndef HGS_VRPTW_ROUTE_H
 #define HGS_VRPTW_ROUTE_H
 
+#include "CircleSector.h"
 #include "Node.h"
 #include "TimeWindowSegment.h"
 
@@ -8,20 +9,58 @@
 #include <bit>
 #include <cassert>
 #include <iosfwd>
+#include <limits>
 
 class Route
 {
-    std::vector<Node *> nodes;  // List of nodes (in order) in this solution.
-
-    // Populates the nodes vector.
-    void setupNodes();
+    // List of nodes (in order) in this route, including the start depot (at
+    // position 0) and the end depot (at position size() + 1).
+    std::vector<Node *> nodes;
+
+    // Cumulative data of the route, indexed by position. Each field is stored
+    // in its own contiguous array (structure of arrays), so scanning (a part
+    // of) the route does not need to visit the nodes.
+    std::vector<int> loads;              // Load from depot to position (incl.)
+    std::vector<int> distances;          // Distance from depot to position
+    std::vector<int> reversalDistances;  // Distance if (0 .. pos) is reversed
+    std::vector<TimeWindowSegment> twsBefore;  // TWS for (0 ... pos) incl.
+    std::vector<TimeWindowSegment> twsAfter;   // TWS for (pos ... 0) incl.
+    std::vector<CircleSector> sectors;         // Sector of (1 ... pos) incl.
+
+    // Disjoint sparse table of time window segments, used to answer twBetween
+    // queries with (at most) a single merge. Level k (stored at index k - 1)
+    // splits the route into blocks of 2^k positions. For a position in the
+    // first half of its block, it stores the TWS from that position up to the
+    // middle of the block; for a position in the second half, the TWS from the
+    // middle up to (and including) that position.
+    mutable std::vector<std::vector<TimeWindowSegment>> twsBlocks;
+
+    // As twsBlocks, but for the segments visited in reverse order. Used to
+    // answer twBetweenReversed queries with a single merge.
+    mutable std::vector<std::vector<TimeWindowSegment>> twsReversedBlocks;
+
+    static constexpr size_t BLOCKS_UP_TO_DATE
+        = std::numeric_limits<size_t>::max();
+
+    // First position whose twsBlocks and twsReversedBlocks entries may be out
+    // of date, or BLOCKS_UP_TO_DATE. Updates only lower this position; the
+    // entries are recomputed on the first query that needs them.
+    mutable size_t staleBlocksFrom = 0;
+
+    // Recomputes the twsBlocks and twsReversedBlocks entries affected by
+    // changes to the route from staleBlocksFrom onwards.
+    void rebuildBlocks() const;
+
+    template <typename DistMat>
+    void rebuildBlocks(DistMat const &distMat) const;
+
+    // Sums of the client coordinates, used to determine the barycenter.
+    int sumX = 0;
+    int sumY = 0;
 
     // Sets the route center angle.
     void setupAngle();
 
-    // Sets forward node time windows.
-    void setupRouteTimeWindows();
-
 public:  // TODO make fields private
     Params const *params;
 
@@ -34,8 +73,7 @@ public:  // TODO make fields private
      */
     [[nodiscard]] Node *operator[](size_t position) const
     {
-        assert(position > 0);
-        return nodes[position - 1];
+        return nodes[position];
     }
 
     /**
@@ -62,22 +100,60 @@ public:  // TODO make fields private
     /**
      * Returns total load on this route.
      */
-    [[nodiscard]] int load() const { return nodes.back()->cumulatedLoad; }
+    [[nodiscard]] int load() const { return loads.back(); }
 
     /**
      * Returns total time warp on this route.
      */
     [[nodiscard]] int timeWarp() const
     {
-        auto const &tw = nodes.back()->twBefore;
-        return tw.totalTimeWarp();
+        return twsBefore.back().totalTimeWarp();
     }
 
+    /**
+     * Returns the circle sector covering the polar angles of this route's
+     * clients. The sector of an empty route is empty.
+     */
+    [[nodiscard]] CircleSector const &sector() const { return sectors.back(); }
+
     [[nodiscard]] bool empty() const { return size() == 0; }
 
     [[nodiscard]] size_t size() const
     {
-        return nodes.size() - 1;  // exclude end depot
+        return nodes.size() - 2;  // exclude start and end depots
+    }
+
+    /**
+     * Returns the load from the depot up to (and including) the given
+     * position.
+     */
+    [[nodiscard]] int loadAt(size_t position) const { return loads[position]; }
+
+    /**
+     * Returns the distance from the depot up to the given position, if that
+     * part of the route were traversed in reverse.
+     */
+    [[nodiscard]] int reversalDistAt(size_t position) const
+    {
+        return reversalDistances[position];
+    }
+
+    /**
+     * Returns time window data for the segment from the depot up to (and
+     * including) the given position.
+     */
+    [[nodiscard]] TimeWindowSegment const &twBefore(size_t position) const
+    {
+        return twsBefore[position];
+    }
+
+    /**
+     * Returns time window data for the segment from the given position up to
+     * (and including) the end depot.
+     */
+    [[nodiscard]] TimeWindowSegment const &twAfter(size_t position) const
+    {
+        return twsAfter[position];
     }
 
     /**
@@ -86,6 +162,13 @@ public:  // TODO make fields private
     [[nodiscard]] inline TimeWindowSegment twBetween(size_t start,
                                                      size_t end) const;
 
+    /**
+     * Calculates time window data for segment [start, end], visited in
+     * reverse order: from end back to start.
+     */
+    [[nodiscard]] inline TimeWindowSegment twBetweenReversed(size_t start,
+                                                             size_t end) const;
+
     /**
      * Calculates the distance for segment [start, end].
      */
@@ -96,31 +179,69 @@ public:  // TODO make fields private
      */
     [[nodiscard]] inline int loadBetween(size_t start, size_t end) const;
 
+    /**
+     * Brings the data used by twBetween() and twBetweenReversed() up to date.
+     * Those queries do this themselves after an update, so this only needs to
+     * be called before the route is queried from several threads at once.
+     */
+    void updateBlocks() const
+    {
+        if (staleBlocksFrom != BLOCKS_UP_TO_DATE)
+            rebuildBlocks();
+    }
+
     /**
      * Updates this route. To be called after swapping nodes/changing the
-     * solution.
+     * solution. Only the data affected by the changed part of the route is
+     * recomputed, and no memory is allocated once the route's arrays have
+     * grown to the route's largest size.
      */
     void update();
 };
 
 TimeWindowSegment Route::twBetween(size_t start, size_t end) const
 {
-    assert(start <= end);
+    assert(start <= end && end < nodes.size());
+
+    if (start == end)
+        return nodes[start]->tw;
+
+    updateBlocks();
+
+    // The highest bit in which start and end differ determines the smallest
+    // block containing both. Start is in the first half of that block, and
+    // end in the second half, so [start, end] is the concatenation of their
+    // entries at that level.
+    auto const level = std::bit_width(start ^ end);
+    auto const &blocks = twsBlocks[level - 1];
+
+    return TimeWindowSegment::merge(
+        params->distanceMatrix(), blocks[start], blocks[end]);
+}
+
+TimeWindowSegment Route::twBetweenReversed(size_t start, size_t end) const
+{
+    assert(start <= end && end < nodes.size());
+
+    if (start == end)
+        return nodes[start]->tw;
 
-    auto data = nodes[start - 1]->tw;
+    updateBlocks();
 
-    for (size_t step = start; step != end; ++step)
-        data = TimeWindowSegment::merge(data, nodes[step]->tw);
+    // See twBetween(), but now the segment runs from end back to start.
+    auto const level = std::bit_width(start ^ end);
+    auto const &blocks = twsReversedBlocks[level - 1];
 
-    return data;
+    return TimeWindowSegment::merge(
+        params->distanceMatrix(), blocks[end], blocks[start]);
 }
 
 int Route::distBetween(size_t start, size_t end) const
 {
-    assert(start <= end && end <= nodes.size());
+    assert(start <= end && end < nodes.size());
 
-    auto const startDist = start == 0 ? 0 : nodes[start - 1]->cumulatedDistance;
-    auto const endDist = nodes[end - 1]->cumulatedDistance;
+    auto const startDist = distances[start];
+    auto const endDist = distances[end];
 
     assert(startDist <= endDist);
 
@@ -129,18 +250,34 @@ int Route::distBetween(size_t start, size_t end) const
 
 int Route::loadBetween(size_t start, size_t end) const
 {
-    assert(start <= end && end <= nodes.size());
+    assert(start <= end && end < nodes.size());
 
-    auto const *startNode = start == 0 ? depot : nodes[start - 1];
-    auto const atStart = params->clients[startNode->client].demand;
-    auto const startLoad = startNode->cumulatedLoad;
-    auto const endLoad = nodes[end - 1]->cumulatedLoad;
+    auto const atStart = params->demand(nodes[start]->client);
+    auto const startLoad = loads[start];
+    auto const endLoad = loads[end];
 
     assert(startLoad <= endLoad);
 
     return endLoad - startLoad + atStart;
 }
 
+TimeWindowSegment const &Node::twBefore() const
+{
+    return route->twBefore(position);
+}
+
+TimeWindowSegment const &Node::twAfter() const
+{
+    return route->twAfter(position);
+}
+
+int Node::cumulatedLoad() const { return route->loadAt(position); }
+
+int Node::cumulatedReversalDistance() const
+{
+    return route->reversalDistAt(position);
+}
+
 // Outputs a route into a given ostream in CVRPLib format
 std::ostream &operator<<(std::ostream &out, Route const &route);
 
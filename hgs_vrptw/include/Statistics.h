@@ -1,6 +1,7 @@
 #ifndef STATISTICS_H
 #define STATISTICS_H
 
+#include "CostEvaluator.h"
 #include "Population.h"
 
 #include <chrono>
@@ -45,9 +46,11 @@ public:
      * called repeatedly during the genetic algorithm's search, and stores
      * relevant data for later evaluation.
      *
-     * @param population  Population object to collect data from.
+     * @param population    Population object to collect data from.
+     * @param costEvaluator Cost evaluator with the current penalty terms.
      */
-    void collectFrom(Population const &population);
+    void collectFrom(Population const &population,
+                     CostEvaluator const &costEvaluator);
 
     /**
      * Returns the total number of iterations.
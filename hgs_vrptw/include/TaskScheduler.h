@@ -0,0 +1,233 @@
+#ifndef TASKSCHEDULER_H
+#define TASKSCHEDULER_H
+
+#include "XorShift128.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing task scheduler. Each worker thread has its own task queue:
+// it runs the most recently added tasks from its own queue first, and steals
+// the oldest tasks of other workers when its own queue is empty. Tasks added
+// by threads that are not workers of this scheduler go to a shared queue.
+// Threads that wait for a task group to complete help run the tasks of that
+// group (and tasks forked from those) in the mean time, so fork/join calls can
+// be nested freely without oversubscribing the available cores. A waiting
+// thread never picks up unrelated tasks, which could keep it from returning
+// long after its own group is done. All parallel features of the solver use
+// the shared scheduler returned by shared(), which cannot be replaced while it
+// is in use.
+class TaskScheduler
+{
+public:
+    class Lease;
+    class TaskGroup;
+
+private:
+    struct Task
+    {
+        std::function<void()> fn;
+        TaskGroup const *group;  // group this task was forked in
+    };
+
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    // One queue for each worker, and a final, shared queue for other threads.
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+
+    std::atomic<size_t> nbQueued = 0;  // number of tasks in the queues
+    std::atomic<size_t> nbPushed = 0;  // number of tasks ever queued
+    bool stopping = false;             // set when the scheduler is destroyed
+
+    std::mutex sleepMutex;  // protects stopping, and used to sleep when idle
+    std::condition_variable sleepCondition;
+
+    // Adds a task to the current thread's queue.
+    void push(Task task);
+
+    // Tries to take a task from the queues and run it. If a group is given,
+    // only tasks of that group or of groups forked within its tasks are
+    // considered. Returns true if a task was run, and false if there were no
+    // such tasks available.
+    bool tryRunTask(TaskGroup const *group = nullptr);
+
+    // Main loop of the worker thread with the given index.
+    void work(size_t idx);
+
+public:
+    /**
+     * Group of tasks that can be waited upon. Tasks are added (forked) using
+     * run(), and wait() waits for all tasks in the group to complete (join).
+     */
+    class TaskGroup
+    {
+        friend class TaskScheduler;
+
+        TaskScheduler &scheduler;
+        TaskGroup const *parent;  // group of the task that created this group
+        std::atomic<size_t> pending = 0;
+
+        std::mutex errorMutex;
+        std::exception_ptr error;
+
+    public:
+        explicit TaskGroup(TaskScheduler &scheduler);
+
+        TaskGroup(TaskGroup const &) = delete;
+        TaskGroup &operator=(TaskGroup const &) = delete;
+
+        /**
+         * Waits for all remaining tasks, but ignores their exceptions.
+         */
+        ~TaskGroup();
+
+        /**
+         * Adds the given task to the scheduler, as part of this group.
+         */
+        void run(std::function<void()> task);
+
+        /**
+         * Waits until all tasks in this group have completed. The calling
+         * thread helps run the tasks of this group, and the tasks those fork,
+         * while it waits. If any of the tasks threw an exception, the first
+         * such exception is rethrown.
+         */
+        void wait();
+    };
+
+    /**
+     * Gives access to the shared scheduler, and marks it as in use for the
+     * lifetime of the lease. Callers hold on to the lease for as long as they
+     * use the scheduler.
+     */
+    class Lease
+    {
+        friend class TaskScheduler;
+
+        TaskScheduler &scheduler;
+
+        explicit Lease(TaskScheduler &scheduler);
+
+    public:
+        Lease(Lease const &) = delete;
+        Lease &operator=(Lease const &) = delete;
+
+        ~Lease();
+
+        TaskScheduler *operator->() const { return &scheduler; }
+
+        TaskScheduler &operator*() const { return scheduler; }
+    };
+
+    /**
+     * Returns the number of threads that run tasks: the worker threads, plus
+     * the thread that waits for the tasks to complete.
+     */
+    [[nodiscard]] size_t numThreads() const { return workers.size() + 1; }
+
+    /**
+     * Calls fn(idx) for each idx in [0, count) as tasks on this scheduler, and
+     * waits for all tasks to complete. The calling thread runs the first task
+     * itself. If any of the tasks throws, the exception of the task with the
+     * lowest index is rethrown once all tasks have completed.
+     */
+    template <typename Fn> void parallelFor(size_t count, Fn const &fn);
+
+    /**
+     * Calls fn(idx, rng) for each idx in [0, count) as tasks on this
+     * scheduler, where rng is a task-local random number generator. The task
+     * generators are split off (in task order) from the given generator, so
+     * they do not depend on the number of threads, or on the order in which
+     * the tasks run.
+     */
+    template <typename Fn>
+    void parallelFor(size_t count, XorShift128 &rng, Fn const &fn);
+
+    /**
+     * Returns a lease on the scheduler shared by all parallel features of the
+     * solver. The scheduler is created when first used, with the number of
+     * threads given by the HGS_NUM_THREADS environment variable, or a single
+     * thread if that is not set, unless setSharedThreads() is called before.
+     */
+    static Lease shared();
+
+    /**
+     * Replaces the shared scheduler by one with the given number of threads.
+     * With one thread, all tasks run on the thread that waits for them. Throws
+     * a runtime_error while any lease on the shared scheduler is held.
+     */
+    static void setSharedThreads(size_t nbThreads);
+
+    /**
+     * Creates a scheduler with the given number of threads. Since the thread
+     * waiting for tasks also runs tasks, this starts nbThreads - 1 workers.
+     */
+    explicit TaskScheduler(size_t nbThreads);
+
+    TaskScheduler(TaskScheduler const &) = delete;
+    TaskScheduler &operator=(TaskScheduler const &) = delete;
+
+    ~TaskScheduler();
+};
+
+template <typename Fn>
+void TaskScheduler::parallelFor(size_t count, Fn const &fn)
+{
+    if (count <= 1 || workers.empty())  // no need to involve other threads
+    {
+        for (size_t idx = 0; idx != count; ++idx)
+            fn(idx);
+
+        return;
+    }
+
+    std::vector<std::exception_ptr> errors(count);
+    auto const call = [&](size_t idx) {
+        try
+        {
+            fn(idx);
+        }
+        catch (...)
+        {
+            errors[idx] = std::current_exception();
+        }
+    };
+
+    TaskGroup group(*this);
+
+    for (size_t idx = 1; idx != count; ++idx)
+        group.run([&call, idx]() { call(idx); });
+
+    call(0);
+    group.wait();
+
+    for (auto const &error : errors)
+        if (error)
+            std::rethrow_exception(error);
+}
+
+template <typename Fn>
+void TaskScheduler::parallelFor(size_t count, XorShift128 &rng, Fn const &fn)
+{
+    std::vector<XorShift128> streams;
+    streams.reserve(count);
+
+    for (size_t idx = 0; idx != count; ++idx)
+        streams.push_back(rng.split());
+
+    parallelFor(count, [&](size_t idx) { fn(idx, streams[idx]); });
+}
+
+#endif  // TASKSCHEDULER_H
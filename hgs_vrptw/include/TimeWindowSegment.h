@@ -1,14 +1,19 @@
 #ifndef TIMEWINDOWDATA_H
 #define TIMEWINDOWDATA_H
 
-#include "Params.h"
+#include "DistanceMatrix.h"
 
+#include <algorithm>
+
+// Time window data of a segment of consecutive visits. The segment does not
+// store a reference to the problem data: merging takes the distance matrix as
+// an argument. This keeps the segment small (seven ints) and trivially
+// copyable. The matrix is either a DistanceMatrix, or one of the matrices
+// passed by DistanceMatrix::visit().
 class TimeWindowSegment
 {
     using TWS = TimeWindowSegment;
 
-    Params const *params = nullptr;
-
     int idxFirst = 0;     // Index of the first client in the segment
     int idxLast = 0;      // Index of the last client in the segment
     int duration = 0;     // Total duration, incl. waiting and servicing
@@ -17,15 +22,15 @@ class TimeWindowSegment
     int twLate = 0;       // Latest visit moment of last client in segment
     int lastRelease = 0;  // Latest release time; cannot leave depot before
 
-    [[nodiscard]] TWS merge(TWS const &other) const
+    template <typename DistMat>
+    [[nodiscard]] TWS merge(DistMat const &distMat, TWS const &other) const
     {
-        int const dist = params->dist(idxLast, other.idxFirst);
+        int const dist = distMat(idxLast, other.idxFirst);
         int const delta = duration - timeWarp + dist;
         int const deltaWaitTime = std::max(other.twEarly - delta - twLate, 0);
         int const deltaTimeWarp = std::max(twEarly + delta - other.twLate, 0);
 
-        return {params,
-                idxFirst,
+        return {idxFirst,
                 other.idxLast,
                 duration + other.duration + dist + deltaWaitTime,
                 timeWarp + other.timeWarp + deltaTimeWarp,
@@ -35,16 +40,41 @@ class TimeWindowSegment
     }
 
 public:
-    template <typename... Args>
-    [[nodiscard]] static TWS
-    merge(TWS const &first, TWS const &second, Args... args)
+    /**
+     * Merges the given segments, in order, using the given distance matrix
+     * for the travel times between consecutive segments.
+     */
+    template <typename DistMat, typename... Args>
+    [[nodiscard]] static TWS merge(DistMat const &distMat,
+                                   TWS const &first,
+                                   TWS const &second,
+                                   Args... args)
     {
-        auto const res = first.merge(second);
+        auto const res = first.merge(distMat, second);
 
         if constexpr (sizeof...(args) == 0)
             return res;
         else
-            return merge(res, args...);
+            return merge(distMat, res, args...);
+    }
+
+    /**
+     * Returns true when this segment is at least as good as the other: any
+     * segment merged after this one results in no more total time warp than
+     * when it is merged after the other. Both segments must end at the same
+     * client, and have the same latest release time.
+     */
+    [[nodiscard]] bool dominates(TWS const &other) const
+    {
+        // Merging adds time warp based on the earliest completion time of the
+        // last client, and the release time based on the latest start and
+        // the segment's net duration (duration - timeWarp).
+        auto const netDuration = duration - timeWarp;
+        auto const otherNetDuration = other.duration - other.timeWarp;
+
+        return timeWarp <= other.timeWarp
+               && twEarly + netDuration <= other.twEarly + otherNetDuration
+               && netDuration <= otherNetDuration && twLate >= other.twLate;
     }
 
     /**
@@ -63,16 +93,14 @@ public:
 
     TimeWindowSegment() = default;  // TODO get rid of this constructor
 
-    TimeWindowSegment(Params const *params,
-                      int idxFirst,
+    TimeWindowSegment(int idxFirst,
                       int idxLast,
                       int duration,
                       int timeWarp,
                       int twEarly,
                       int twLate,
                       int latestReleaseTime)
-        : params(params),
-          idxFirst(idxFirst),
+        : idxFirst(idxFirst),
           idxLast(idxLast),
           duration(duration),
           timeWarp(timeWarp),
@@ -64,6 +64,48 @@ public:
         static_assert(std::is_integral<T>::value);
         return operator()() % high;
     }
+
+    /**
+     * Advances the generator by 2^64 steps, in the time of 128 steps. The
+     * generator has period 2^128 - 1, so repeated jumps yield 2^64 disjoint
+     * streams of 2^64 numbers each.
+     */
+    void jump()
+    {
+        // Coefficients of x^(2^64) modulo the characteristic polynomial of the
+        // generator's (linear) transition function.
+        static constexpr unsigned JUMP[]
+            = {0x35AAC71C, 0x821E5343, 0xF52E65C4, 0xD8CD644E};
+
+        unsigned jumped[4]{};
+
+        for (auto const coefficients : JUMP)
+            for (unsigned bit = 0; bit != 32; ++bit)
+            {
+                if (coefficients & (1u << bit))
+                    for (size_t idx = 0; idx != 4; ++idx)
+                        jumped[idx] ^= state_[idx];
+
+                operator()();
+            }
+
+        for (size_t idx = 0; idx != 4; ++idx)
+            state_[idx] = jumped[idx];
+    }
+
+    /**
+     * Splits off an independent stream of random numbers: returns a copy of
+     * this generator, and then jumps this generator ahead (see jump()). The
+     * streams returned by successive calls do not overlap with each other, or
+     * with the numbers this generator returns afterwards (unless more than
+     * 2^64 numbers are drawn from a stream).
+     */
+    XorShift128 split()
+    {
+        auto stream = *this;
+        jump();
+        return stream;
+    }
 };
 
 #endif
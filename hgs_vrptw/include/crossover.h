@@ -1,6 +1,7 @@
 #ifndef CROSSOVER_H
 #define CROSSOVER_H
 
+#include "CostEvaluator.h"
 #include "Individual.h"
 #include "Params.h"
 #include "XorShift128.h"
@@ -29,6 +30,7 @@ void greedyRepair(std::vector<std::vector<int>> &routes,
 Individual selectiveRouteExchange(
     std::pair<Individual const *, Individual const *> const &parents,
     Params const &params,
+    CostEvaluator const &costEvaluator,
     XorShift128 &rng);
 
 #endif  // CROSSOVER_H
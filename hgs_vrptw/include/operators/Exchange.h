@@ -25,15 +25,29 @@ template <size_t N, size_t M> class Exchange : public LocalSearchOperator<Node>
     inline bool adjacent(Node *U, Node *V) const;
 
     // Special case that's applied when M == 0
-    int evalRelocateMove(Node *U, Node *V) const;
+    template <typename DistMat>
+    int evalRelocateMove(DistMat const &distMat,
+                         Node *U,
+                         Node *V,
+                         CostEvaluator const &costEvaluator) const;
 
     // Applied when M != 0
-    int evalSwapMove(Node *U, Node *V) const;
+    template <typename DistMat>
+    int evalSwapMove(DistMat const &distMat,
+                     Node *U,
+                     Node *V,
+                     CostEvaluator const &costEvaluator) const;
 
 public:
-    int evaluate(Node *U, Node *V) override;
+    int evaluate(Node *U, Node *V, CostEvaluator const &costEvaluator) override;
 
     void apply(Node *U, Node *V) override;
+
+    [[nodiscard]] std::unique_ptr<LocalSearchOperator<Node>>
+    clone(Params const &params) const override
+    {
+        return std::make_unique<Exchange<N, M>>(params);
+    }
 };
 
 #endif  // EXCHANGE_H
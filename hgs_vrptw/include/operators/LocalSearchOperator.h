@@ -1,9 +1,12 @@
 #ifndef LOCALSEARCHOPERATOR_H
 #define LOCALSEARCHOPERATOR_H
 
+#include "CostEvaluator.h"
 #include "Individual.h"
 #include "Route.h"
 
+#include <memory>
+
 template <typename Arg> class LocalSearchOperator
 {
 protected:
@@ -17,8 +20,9 @@ public:
     virtual void init(Individual const &indiv){};
 
     /**
-     * Determines the cost delta of applying this operator to the arguments.
-     * If the cost delta is negative, this is an improving move.
+     * Determines the cost delta of applying this operator to the arguments,
+     * using the penalty terms of the given cost evaluator. If the cost delta
+     * is negative, this is an improving move.
      * <br />
      * The contract is as follows: if the cost delta is negative, that is the
      * true cost delta of this move. As such, improving moves are fully
@@ -27,7 +31,11 @@ public:
      * cannot become negative at all. In that case, the returned (non-negative)
      * cost delta does not constitute a full evaluation.
      */
-    virtual int evaluate(Arg *U, Arg *V) { return false; }
+    virtual int
+    evaluate(Arg *U, Arg *V, CostEvaluator const &costEvaluator)
+    {
+        return false;
+    }
 
     /**
      * Applies this operator to the given arguments. For improvements, should
@@ -42,6 +50,33 @@ public:
      */
     virtual void update(Route *U){};
 
+    /**
+     * Returns a new operator of the same type, working on the given problem
+     * parameters. This is used to give each independent search (for example,
+     * each island of the genetic algorithm) its own operator state.
+     */
+    [[nodiscard]] virtual std::unique_ptr<LocalSearchOperator<Arg>>
+    clone(Params const &params) const = 0;
+
+    /**
+     * Called before pairs of arguments are evaluated concurrently, once for
+     * each argument that takes part. Afterwards, evaluating a pair of prepared
+     * arguments does not modify state that other pairs' evaluations use.
+     */
+    virtual void prepare(Arg *U, CostEvaluator const &costEvaluator){};
+
+    /**
+     * Returns an operator that evaluates moves for this operator on another
+     * thread, after the arguments are prepared. It shares the caches of this
+     * operator rather than copying them, and must only be used for
+     * <code>evaluate()</code> while the arguments are not changed. By default
+     * this is a clone, which suits operators without such caches.
+     */
+    [[nodiscard]] virtual std::unique_ptr<LocalSearchOperator<Arg>> scratch()
+    {
+        return clone(d_params);
+    }
+
     explicit LocalSearchOperator(Params const &params) : d_params(params) {}
 
     virtual ~LocalSearchOperator() = default;
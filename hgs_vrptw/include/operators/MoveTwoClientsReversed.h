@@ -11,8 +11,14 @@ class MoveTwoClientsReversed : public LocalSearchOperator<Node>
 {
     using LocalSearchOperator::LocalSearchOperator;
 
+    template <typename DistMat>
+    int evalMove(DistMat const &distMat,
+                 Node *U,
+                 Node *V,
+                 CostEvaluator const &costEvaluator) const;
+
 public:
-    int evaluate(Node *U, Node *V) override;
+    int evaluate(Node *U, Node *V, CostEvaluator const &costEvaluator) override;
 
     void apply(Node *U, Node *V) override
     {
@@ -21,6 +27,12 @@ public:
         U->insertAfter(V);
         X->insertAfter(V);
     }
+
+    [[nodiscard]] std::unique_ptr<LocalSearchOperator<Node>>
+    clone(Params const &params) const override
+    {
+        return std::make_unique<MoveTwoClientsReversed>(params);
+    }
 };
 
 #endif  // MOVETWOCLIENTSREVERSED_H
@@ -29,10 +29,17 @@ public:
         relocate.init(indiv);
     }
 
-    int evaluate(Route *U, Route *V) override;
+    int
+    evaluate(Route *U, Route *V, CostEvaluator const &costEvaluator) override;
 
     void apply(Route *U, Route *V) override { move.from->insertAfter(move.to); }
 
+    [[nodiscard]] std::unique_ptr<LocalSearchOperator<Route>>
+    clone(Params const &params) const override
+    {
+        return std::make_unique<RelocateStar>(params);
+    }
+
     explicit RelocateStar(Params const &params)
         : LocalSearchOperator<Route>(params), relocate(params)
     {
@@ -7,6 +7,7 @@
 #include "Route.h"
 
 #include <array>
+#include <memory>
 #include <vector>
 
 /**
@@ -69,36 +70,85 @@ class SwapStar : public LocalSearchOperator<Route>
     };
 
     // Updates the removal costs of clients in the given route
-    void updateRemovalCosts(Route *R1);
+    template <typename DistMat>
+    void updateRemovalCosts(DistMat const &distMat,
+                            Route *R1,
+                            CostEvaluator const &costEvaluator);
 
     // Updates the cache storing the three best positions in the given route for
     // the passed-in node (client).
-    void updateInsertionCost(Route *R, Node *U);
+    template <typename DistMat>
+    void updateInsertionCost(DistMat const &distMat,
+                             Route *R,
+                             Node *U,
+                             CostEvaluator const &costEvaluator);
 
     // Gets the delta cost and reinsert point for U in the route of V, assuming
     // V is removed.
-    inline std::pair<int, Node *> getBestInsertPoint(Node *U, Node *V);
-
-    Matrix<ThreeBest> cache;
-    Matrix<int> removalCosts;
-    std::vector<bool> updated;
+    template <typename DistMat>
+    inline std::pair<int, Node *>
+    getBestInsertPoint(DistMat const &distMat,
+                       Node *U,
+                       Node *V,
+                       CostEvaluator const &costEvaluator);
+
+    // Determines the best SWAP* move between the given (prepared) routes
+    template <typename DistMat>
+    int evalMove(DistMat const &distMat,
+                 Route *routeU,
+                 Route *routeV,
+                 CostEvaluator const &costEvaluator);
+
+    struct Caches  // route and client data, shared with scratch operators
+    {
+        AlignedMatrix<ThreeBest> insertPositions;
+        AlignedMatrix<int> removalCosts;
+        std::vector<bool> updated;
+
+        Caches(size_t nbRoutes, size_t nbClients)
+            : insertPositions(nbRoutes, nbClients + 1),
+              removalCosts(nbRoutes, nbClients + 1),
+              updated(nbRoutes, true)
+        {
+        }
+    };
 
+    std::shared_ptr<Caches> caches;
     BestMove best;
 
+    // Creates a scratch operator that shares the given caches
+    SwapStar(Params const &params, std::shared_ptr<Caches> caches)
+        : LocalSearchOperator<Route>(params), caches(std::move(caches))
+    {
+    }
+
 public:
     void init(Individual const &indiv) override;
 
-    int evaluate(Route *U, Route *V) override;
+    int
+    evaluate(Route *U, Route *V, CostEvaluator const &costEvaluator) override;
 
     void apply(Route *U, Route *V) override;
 
-    void update(Route *U) override { updated[U->idx] = true; }
+    void update(Route *U) override { caches->updated[U->idx] = true; }
+
+    void prepare(Route *U, CostEvaluator const &costEvaluator) override;
+
+    [[nodiscard]] std::unique_ptr<LocalSearchOperator<Route>>
+    clone(Params const &params) const override
+    {
+        return std::make_unique<SwapStar>(params);
+    }
+
+    [[nodiscard]] std::unique_ptr<LocalSearchOperator<Route>> scratch() override
+    {
+        return std::unique_ptr<SwapStar>(new SwapStar(d_params, caches));
+    }
 
     explicit SwapStar(Params const &params)
         : LocalSearchOperator<Route>(params),
-          cache(d_params.nbVehicles, d_params.nbClients + 1),
-          removalCosts(d_params.nbVehicles, d_params.nbClients + 1),
-          updated(d_params.nbVehicles, true)
+          caches(std::make_shared<Caches>(d_params.nbVehicles,
+                                          d_params.nbClients))
     {
     }
 };
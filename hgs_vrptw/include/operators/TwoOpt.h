@@ -15,18 +15,32 @@ class TwoOpt : public LocalSearchOperator<Node>
 {
     using LocalSearchOperator::LocalSearchOperator;
 
-    int evalWithinRoute(Node *U, Node *V);
-
-    int evalBetweenRoutes(Node *U, Node *V);
+    template <typename DistMat>
+    int evalWithinRoute(DistMat const &distMat,
+                        Node *U,
+                        Node *V,
+                        CostEvaluator const &costEvaluator);
+
+    template <typename DistMat>
+    int evalBetweenRoutes(DistMat const &distMat,
+                          Node *U,
+                          Node *V,
+                          CostEvaluator const &costEvaluator);
 
     void applyWithinRoute(Node *U, Node *V);
 
     void applyBetweenRoutes(Node *U, Node *V);
 
 public:
-    int evaluate(Node *U, Node *V) override;
+    int evaluate(Node *U, Node *V, CostEvaluator const &costEvaluator) override;
 
     void apply(Node *U, Node *V) override;
+
+    [[nodiscard]] std::unique_ptr<LocalSearchOperator<Node>>
+    clone(Params const &params) const override
+    {
+        return std::make_unique<TwoOpt>(params);
+    }
 };
 
 #endif  // TWOOPT_H
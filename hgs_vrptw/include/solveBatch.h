@@ -0,0 +1,39 @@
+#ifndef SOLVEBATCH_H
+#define SOLVEBATCH_H
+
+#include "GeneticAlgorithm.h"
+#include "LocalSearchOperator.h"
+#include "Node.h"
+#include "Params.h"
+#include "Result.h"
+#include "Route.h"
+#include "StoppingCriterion.h"
+
+#include <vector>
+
+/**
+ * Solves each of the given instances independently with the genetic
+ * algorithm, in one task per instance on the shared task scheduler. The
+ * number of concurrent solves is thus limited by the number of scheduler
+ * threads (see TaskScheduler::setSharedThreads). Each solve sets up its
+ * own random number generator (seeded from the instance's config), population,
+ * and local search. The local search operators are copies of the given
+ * operators, and the stopping criterion is cloned when a solve starts. This
+ * function does not need the Python GIL, unless a crossover operator is
+ * implemented in Python.
+ *
+ * @param instances    Instances to solve.
+ * @param nodeOps      Node operators to use in the local search.
+ * @param routeOps     Route operators to use in the local search.
+ * @param crossoverOps Crossover operators to use in the genetic algorithm.
+ * @param stop         Stopping criterion to use for each solve.
+ * @return             Results, in the same order as the given instances.
+ */
+std::vector<Result>
+solveBatch(std::vector<Params const *> const &instances,
+           std::vector<LocalSearchOperator<Node> const *> const &nodeOps,
+           std::vector<LocalSearchOperator<Route> const *> const &routeOps,
+           std::vector<GeneticAlgorithm::xOp> const &crossoverOps,
+           StoppingCriterion const &stop);
+
+#endif  // SOLVEBATCH_H
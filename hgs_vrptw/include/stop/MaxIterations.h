@@ -11,6 +11,11 @@ class MaxIterations : public StoppingCriterion
 public:
     bool operator()() override { return maxIters < ++currIters; }
 
+    [[nodiscard]] std::unique_ptr<StoppingCriterion> clone() const override
+    {
+        return std::make_unique<MaxIterations>(maxIters);
+    }
+
     explicit MaxIterations(size_t const maxIterations) : maxIters(maxIterations)
     {
         if (maxIterations == 0)
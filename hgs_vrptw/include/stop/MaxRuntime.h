@@ -4,6 +4,7 @@
 #include "StoppingCriterion.h"
 
 #include <chrono>
+#include <limits>
 
 class MaxRuntime : public StoppingCriterion
 {
@@ -11,22 +12,56 @@ class MaxRuntime : public StoppingCriterion
     using seconds = std::chrono::duration<double>;
 
     double const maxRuntime;
+    double const maxTotalRuntime;
     clock::time_point const start;
+    clock::time_point const origin;  // construction of the original criterion
+
+    MaxRuntime(double maxRuntime,
+               double maxTotalRuntime,
+               clock::time_point origin)
+        : maxRuntime(maxRuntime),
+          maxTotalRuntime(maxTotalRuntime),
+          start(clock::now()),
+          origin(origin)
+    {
+    }
 
 public:
     bool operator()() override
     {
-        return seconds(clock::now() - start).count() >= maxRuntime;
+        auto const now = clock::now();
+        return seconds(now - start).count() >= maxRuntime
+               || seconds(now - origin).count() >= maxTotalRuntime;
+    }
+
+    /**
+     * Returns a new criterion with the same maximum run time, that starts
+     * counting from the moment it is cloned. The maximum total run time is
+     * still counted from the construction of the original criterion.
+     */
+    [[nodiscard]] std::unique_ptr<StoppingCriterion> clone() const override
+    {
+        return std::unique_ptr<StoppingCriterion>(
+            new MaxRuntime(maxRuntime, maxTotalRuntime, origin));
     }
 
     /**
      * Sets a maximum run time, in seconds. Note that the counter starts from
-     * the moment this object is first constructed.
+     * the moment this object is first constructed. The optional maximum total
+     * run time bounds this criterion and all its clones: they stop once that
+     * many seconds have passed since this object was constructed. That
+     * bounds a batch of solves that each use a clone, however the solves are
+     * scheduled.
      */
-    explicit MaxRuntime(double const maxRuntime)
-        : maxRuntime(maxRuntime), start(clock::now())
+    explicit MaxRuntime(double const maxRuntime,
+                        double const maxTotalRuntime
+                        = std::numeric_limits<double>::infinity())
+        : maxRuntime(maxRuntime),
+          maxTotalRuntime(maxTotalRuntime),
+          start(clock::now()),
+          origin(start)
     {
-        if (maxRuntime <= 0)
+        if (maxRuntime <= 0 || maxTotalRuntime <= 0)
             throw std::runtime_error("Run-time <= 0 is not understood.");
     }
 };
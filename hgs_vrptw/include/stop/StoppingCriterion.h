@@ -1,11 +1,19 @@
 #ifndef STOPPINGCRITERION_H
 #define STOPPINGCRITERION_H
 
+#include <memory>
+
 class StoppingCriterion
 {
 public:
     virtual bool operator()() = 0;
 
+    /**
+     * Returns a new stopping criterion with the same settings as this one, but
+     * in its initial state: it is as if the criterion was constructed anew.
+     */
+    [[nodiscard]] virtual std::unique_ptr<StoppingCriterion> clone() const = 0;
+
     virtual ~StoppingCriterion() = default;
 };
 
@@ -0,0 +1,18 @@
+#include "CostEvaluator.h"
+
+#include "Params.h"
+
+CostEvaluator::CostEvaluator(Params const &params)
+    : vehicleCapacity(params.vehicleCapacity)
+{
+    int maxDemand = 0;
+    for (int client = 0; client <= params.nbClients; ++client)
+        maxDemand = std::max(maxDemand, params.demand(client));
+
+    // A reasonable scale for the initial values of the penalties
+    int const initCapPenalty = params.maxDist() / std::max(maxDemand, 1);
+    penaltyCapacity_ = std::max(std::min(1000, initCapPenalty), 1);
+
+    // Initial parameter values of this parameter is not argued
+    penaltyTimeWarp_ = static_cast<int>(params.config.initialTimeWarpPenalty);
+}
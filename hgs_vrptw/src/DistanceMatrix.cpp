@@ -0,0 +1,31 @@
+#include "DistanceMatrix.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+DistanceMatrix::DistanceMatrix(Matrix<int> const &distances)
+    : dimension_(distances.numRows())
+{
+    if (distances.numRows() != distances.numCols())
+        throw std::invalid_argument("Distance matrix must be square.");
+
+    auto const fitsNarrow = [](int dist) {
+        return 0 <= dist && dist <= UINT16_MAX;
+    };
+
+    isNarrow_ = std::all_of(distances.begin(), distances.end(), fitsNarrow);
+
+    auto const copy = [&](auto &matrix) {
+        matrix = std::remove_reference_t<decltype(matrix)>(dimension_);
+
+        for (size_t row = 0; row != dimension_; ++row)
+            for (size_t col = 0; col != dimension_; ++col)
+                matrix(row, col) = distances(row, col);
+    };
+
+    if (isNarrow_)
+        copy(narrow_);
+    else
+        copy(wide_);
+}
@@ -1,83 +1,253 @@
 #include "GeneticAlgorithm.h"
 
+#include "InUseGuard.h"
 #include "Individual.h"
 #include "LocalSearch.h"
 #include "Params.h"
 #include "Population.h"
 #include "Result.h"
 #include "Statistics.h"
+#include "TaskScheduler.h"
 
 #include <chrono>
+#include <memory>
 #include <numeric>
 #include <stdexcept>
 
+struct GeneticAlgorithm::Island
+{
+    XorShift128 rng;
+    Population population;
+    LocalSearch localSearch;
+    GeneticAlgorithm algo;
+
+    Island(GeneticAlgorithm const &other, XorShift128 stream)
+        : rng(stream),
+          population(other.params, rng, CostEvaluator(other.params)),
+          localSearch(other.localSearch, rng),
+          algo(other.params, rng, population, localSearch)
+    {
+        for (auto const &op : other.operators)
+            algo.addCrossoverOperator(op);
+    }
+};
+
 Result GeneticAlgorithm::run(StoppingCriterion &stop)
 {
     using clock = std::chrono::system_clock;
+    InUseGuard guard(inUse, "GeneticAlgorithm");
+
+    // The parallel parts of a run use the shared scheduler, so it should not
+    // be replaced before the run completes.
+    auto const lease = TaskScheduler::shared();
 
     if (operators.empty())
         throw std::runtime_error("Cannot run genetic algorithm without "
                                  "crossover operators.");
 
-    Statistics stats;
-
-    size_t iter = 0;
-    size_t nbIterNoImprove = 1;
+    iter = 0;
+    nbIterNoImprove = 1;
+    stats = {};
 
     if (params.nbClients <= 1)
-        return {population.getBestFound(), stats, iter, 0.};
+        return {population.getBestFound(), costEvaluator, stats, iter, 0.};
+
+    if (params.config.nbIslands > 1)
+        return runIslands(stop);
 
     auto start = clock::now();
     while (not stop())
+        step();
+
+    std::chrono::duration<double> runTime = clock::now() - start;
+    return {population.getBestFound(),
+            costEvaluator,
+            stats,
+            iter,
+            runTime.count()};
+}
+
+Result GeneticAlgorithm::runIslands(StoppingCriterion &stop)
+{
+    using clock = std::chrono::system_clock;
+
+    if (params.config.migrationInterval == 0)
+        throw std::runtime_error("Migration interval must be positive.");
+
+    auto start = clock::now();
+    auto const nbIslands = params.config.nbIslands;
+
+    // This object is the first island. The other islands have their own
+    // state, but share the problem parameters and use the same operators.
+    // Their random number streams are split off from this object's stream.
+    std::vector<std::unique_ptr<Island>> islands;
+    std::vector<GeneticAlgorithm *> algos = {this};
+
+    for (size_t idx = 1; idx != nbIslands; ++idx)
     {
-        iter++;
+        islands.push_back(std::make_unique<Island>(*this, rng.split()));
+        algos.push_back(&islands.back()->algo);
+    }
 
-        if (nbIterNoImprove == params.config.nbIter)  // restart population
-        {                                             // after this number of
-            population.restart();                     // non-improving iters
-            nbIterNoImprove = 1;
-        }
+    // The stopping criterion is evaluated once per round, where round r
+    // consists of the r-th iteration of every island. The islands' iterations
+    // of a round are run as tasks on the shared scheduler.
+    auto const scheduler = TaskScheduler::shared();
 
-        auto const currBest = population.getCurrentBestFeasibleCost();
+    for (size_t round = 1; !stop(); ++round)
+    {
+        scheduler->parallelFor(nbIslands,
+                               [&](size_t idx) { algos[idx]->step(); });
 
-        auto offspring = crossover();
-        educate(offspring);
+        if (round % params.config.migrationInterval != 0)
+            continue;
 
-        auto const newBest = population.getCurrentBestFeasibleCost();
+        // Ring migration: the best solution of each island is inserted into
+        // the population of the next island. The migrants are collected first,
+        // so the result does not depend on the order of insertion.
+        std::vector<Individual> migrants;
+        for (auto const *algo : algos)
+            migrants.push_back(algo->population.getBestFound());
 
-        if (newBest < currBest)  // has new best!
-            nbIterNoImprove = 1;
-        else
-            nbIterNoImprove++;
+        for (size_t idx = 0; idx != nbIslands; ++idx)
+        {
+            auto const &migrant = migrants[(idx + nbIslands - 1) % nbIslands];
+            auto *algo = algos[idx];
 
-        // Diversification and penalty management
-        if (iter % params.config.nbPenaltyManagement == 0)
+            if (migrant.isFeasible())
+                algo->population.addIndividual(migrant, algo->costEvaluator);
+        }
+    }
+
+    auto const *best = &population.getBestFound();
+    auto const *bestEvaluator = &costEvaluator;
+    std::vector<size_t> islandIters;
+    size_t totalIters = 0;
+
+    for (auto const *algo : algos)
+    {
+        auto const &candidate = algo->population.getBestFound();
+
+        if (candidate.isFeasible()
+            && (!best->isFeasible()
+                || candidate.cost(costEvaluator) < best->cost(costEvaluator)))
         {
-            updatePenalties();
-            population.reorder();  // re-order since penalties have changed
+            best = &candidate;
+            bestEvaluator = &algo->costEvaluator;
         }
 
-        if (params.config.collectStatistics)
-            stats.collectFrom(population);
+        islandIters.push_back(algo->iter);
+        totalIters += algo->iter;
     }
 
     std::chrono::duration<double> runTime = clock::now() - start;
-    return {population.getBestFound(), stats, iter, runTime.count()};
+    return {*best,
+            *bestEvaluator,
+            stats,
+            totalIters,
+            runTime.count(),
+            islandIters};
+}
+
+void GeneticAlgorithm::step()
+{
+    // Iterations are counted per offspring, so nbIter and nbPenaltyManagement
+    // mean the same with and without batches.
+    auto const nbOffspring = std::max<size_t>(params.config.batchSize, 1);
+    iter += nbOffspring;
+
+    if (nbIterNoImprove >= params.config.nbIter)  // restart population after
+    {                                             // this number of non-
+        population.restart(costEvaluator);        // improving iterations
+        nbIterNoImprove = 1;
+    }
+
+    auto const currBest = population.getCurrentBestFeasibleCost();
+
+    if (params.config.batchSize > 1)
+        stepBatch();
+    else
+    {
+        auto offspring = crossover(population.selectParents(), rng);
+        auto const &best = population.getBestFound();
+
+        for (auto const &indiv : educate(offspring, localSearch, rng, best))
+            addIndividual(indiv);
+    }
+
+    auto const newBest = population.getCurrentBestFeasibleCost();
+
+    if (newBest < currBest)  // has new best!
+        nbIterNoImprove = 1;
+    else
+        nbIterNoImprove += nbOffspring;
+
+    // Diversification and penalty management. A batch need not end exactly
+    // at a multiple of nbPenaltyManagement, so we test if it passed one.
+    auto const nbPenalty = params.config.nbPenaltyManagement;
+    if (iter / nbPenalty != (iter - nbOffspring) / nbPenalty)
+    {
+        updatePenalties();
+        population.reorder(costEvaluator);  // since penalties have changed
+    }
+
+    if (params.config.collectStatistics)
+        stats.collectFrom(population, costEvaluator);
 }
 
-Individual GeneticAlgorithm::crossover() const
+void GeneticAlgorithm::stepBatch()
 {
-    auto const parents = population.selectParents();
+    auto const batchSize = params.config.batchSize;
+
+    while (workers.size() < batchSize)
+        workers.push_back(std::make_unique<Worker>(localSearch));
+
+    // Parents are selected up front using the main random number generator,
+    // so the batch does not depend on how it is scheduled.
+    std::vector<Parents> parents;
+    for (size_t idx = 0; idx != batchSize; ++idx)
+        parents.push_back(population.selectParents());
+
+    // Each offspring is a task with its own random number stream, and the
+    // i-th offspring is always educated by the i-th worker (whose local search
+    // keeps some state between searches). Together with adding the results
+    // in offspring order, this makes the results independent of the number of
+    // threads, and of the order in which the tasks run.
+    auto const &best = population.getBestFound();
+    std::vector<std::vector<Individual>> educated(batchSize);
+
+    auto const educateOne = [&](size_t idx, XorShift128 &taskRng) {
+        auto &worker = *workers[idx];
+        worker.rng = taskRng;
+
+        auto offspring = crossover(parents[idx], worker.rng);
+        auto &ls = worker.localSearch;
+        educated[idx] = educate(offspring, ls, worker.rng, best);
+    };
+
+    TaskScheduler::shared()->parallelFor(batchSize, rng, educateOne);
+
+    for (auto const &individuals : educated)
+        for (auto const &indiv : individuals)
+            addIndividual(indiv);
+}
 
+Individual GeneticAlgorithm::crossover(Parents const &parents,
+                                       XorShift128 &rng) const
+{
     std::vector<Individual> offspring;
     offspring.reserve(operators.size());
 
     for (auto const &op : operators)
-        offspring.push_back(op(parents, params, rng));
+        offspring.push_back(op(parents, params, costEvaluator, rng));
 
     // A simple geometric acceptance criterion: select the best with some
     // probability. If not accepted, test the second best, etc.
-    std::sort(offspring.begin(), offspring.end());
+    auto const cmp = [&](auto const &indiv1, auto const &indiv2) {
+        return indiv1.cost(costEvaluator) < indiv2.cost(costEvaluator);
+    };
+
+    std::sort(offspring.begin(), offspring.end(), cmp);
 
     for (auto &indiv : offspring)
         if (rng.randint(100) < params.config.selectProbability)
@@ -86,39 +256,50 @@ Individual GeneticAlgorithm::crossover() const
     return offspring.back();  // fallback in case no offspring were selected
 }
 
-void GeneticAlgorithm::educate(Individual &indiv)
+std::vector<Individual> GeneticAlgorithm::educate(Individual &indiv,
+                                                  LocalSearch &ls,
+                                                  XorShift128 &rng,
+                                                  Individual const &best) const
 {
-    localSearch.search(indiv);
+    ls.search(indiv, costEvaluator);
 
     if (params.config.shouldIntensify  // only intensify feasible, new best
         && indiv.isFeasible()          // solutions. Cf. also repair below.
-        && indiv < population.getBestFound())
-        localSearch.intensify(indiv);
-
-    population.addIndividual(indiv);
+        && indiv.cost(costEvaluator) < best.cost(costEvaluator))
+        ls.intensify(indiv, costEvaluator);
 
-    loadFeas.push_back(!indiv.hasExcessCapacity());
-    timeFeas.push_back(!indiv.hasTimeWarp());
+    std::vector<Individual> educated = {indiv};
 
     if (!indiv.isFeasible()  // possibly repair if currently infeasible
         && rng.randint(100) < params.config.repairProbability)
     {
-        // Re-run, but penalise infeasibility more using a penalty booster.
-        auto const booster = params.getPenaltyBooster();
-        localSearch.search(indiv);
+        // Re-run, but penalise infeasibility more using boosted penalties.
+        auto const booster = static_cast<int>(params.config.repairBooster);
+        CostEvaluator const boosted(booster * costEvaluator.penaltyCapacity(),
+                                    booster * costEvaluator.penaltyTimeWarp(),
+                                    params.vehicleCapacity);
+
+        ls.search(indiv, boosted);
 
         if (indiv.isFeasible())
         {
             if (params.config.shouldIntensify
-                && indiv < population.getBestFound())
-                localSearch.intensify(indiv);
-
-            population.addIndividual(indiv);
+                && indiv.cost(boosted) < best.cost(boosted))
+                ls.intensify(indiv, boosted);
 
-            loadFeas.push_back(!indiv.hasExcessCapacity());
-            timeFeas.push_back(!indiv.hasTimeWarp());
+            educated.push_back(indiv);
         }
     }
+
+    return educated;
+}
+
+void GeneticAlgorithm::addIndividual(Individual const &indiv)
+{
+    population.addIndividual(indiv, costEvaluator);
+
+    loadFeas.push_back(!indiv.hasExcessCapacity());
+    timeFeas.push_back(!indiv.hasTimeWarp());
 }
 
 void GeneticAlgorithm::updatePenalties()
@@ -142,18 +323,23 @@ void GeneticAlgorithm::updatePenalties()
     double fracFeasTime = std::accumulate(timeFeas.begin(), timeFeas.end(), 0.);
     fracFeasTime /= static_cast<double>(timeFeas.size());
 
-    params.penaltyCapacity = compute(fracFeasLoad, params.penaltyCapacity);
-    params.penaltyTimeWarp = compute(fracFeasTime, params.penaltyTimeWarp);
+    costEvaluator = {compute(fracFeasLoad, costEvaluator.penaltyCapacity()),
+                     compute(fracFeasTime, costEvaluator.penaltyTimeWarp()),
+                     params.vehicleCapacity};
 
     loadFeas.clear();
     timeFeas.clear();
 }
 
-GeneticAlgorithm::GeneticAlgorithm(Params &params,
+GeneticAlgorithm::GeneticAlgorithm(Params const &params,
                                    XorShift128 &rng,
                                    Population &population,
                                    LocalSearch &localSearch)
-    : params(params), rng(rng), population(population), localSearch(localSearch)
+    : params(params),
+      rng(rng),
+      population(population),
+      localSearch(localSearch),
+      costEvaluator(params)
 {
     loadFeas.reserve(params.config.nbPenaltyManagement);
     timeFeas.reserve(params.config.nbPenaltyManagement);
@@ -8,36 +8,33 @@
 void Individual::evaluateCompleteCost()
 {
     // Reset fields before evaluating them again below.
-    nbRoutes = 0;
-    distance = 0;
+    distance_ = 0;
     capacityExcess = 0;
     timeWarp = 0;
 
-    for (auto const &route : routes_)
-    {
-        if (route.empty())  // First empty route. All subsequent routes are
-            break;          // empty as well
+    auto const routes = getRoutes();
 
-        nbRoutes++;
+    for (size_t rIdx = 0; rIdx != nbRoutes; ++rIdx)
+    {
+        auto const route = routes[rIdx];
 
         int lastRelease = 0;
         for (auto const idx : route)
-            lastRelease
-                = std::max(lastRelease, params->clients[idx].releaseTime);
+            lastRelease = std::max(lastRelease, params->releaseTime(idx));
 
         int rDist = params->dist(0, route[0]);
         int rTimeWarp = 0;
 
-        int load = params->clients[route[0]].demand;
+        int load = params->demand(route[0]);
         int time = lastRelease + rDist;
 
-        if (time < params->clients[route[0]].twEarly)
-            time = params->clients[route[0]].twEarly;
+        if (time < params->twEarly(route[0]))
+            time = params->twEarly(route[0]);
 
-        if (time > params->clients[route[0]].twLate)
+        if (time > params->twLate(route[0]))
         {
-            rTimeWarp += time - params->clients[route[0]].twLate;
-            time = params->clients[route[0]].twLate;
+            rTimeWarp += time - params->twLate(route[0]);
+            time = params->twLate(route[0]);
         }
 
         for (size_t idx = 1; idx < route.size(); idx++)
@@ -45,35 +42,34 @@ void Individual::evaluateCompleteCost()
             // Sum the rDist, load, servDur and time associated with the vehicle
             // traveling from the depot to the next client
             rDist += params->dist(route[idx - 1], route[idx]);
-            load += params->clients[route[idx]].demand;
+            load += params->demand(route[idx]);
 
-            time += params->clients[route[idx - 1]].servDur
+            time += params->servDur(route[idx - 1])
                     + params->dist(route[idx - 1], route[idx]);
 
             // Add possible waiting time
-            if (time < params->clients[route[idx]].twEarly)
-                time = params->clients[route[idx]].twEarly;
+            if (time < params->twEarly(route[idx]))
+                time = params->twEarly(route[idx]);
 
             // Add possible time warp
-            if (time > params->clients[route[idx]].twLate)
+            if (time > params->twLate(route[idx]))
             {
-                rTimeWarp += time - params->clients[route[idx]].twLate;
-                time = params->clients[route[idx]].twLate;
+                rTimeWarp += time - params->twLate(route[idx]);
+                time = params->twLate(route[idx]);
             }
         }
 
         // For the last client, the successors is the depot. Also update the
         // rDist and time
         rDist += params->dist(route.back(), 0);
-        time += params->clients[route.back()].servDur
-                + params->dist(route.back(), 0);
+        time += params->servDur(route.back()) + params->dist(route.back(), 0);
 
         // For the depot, we only need to check the end of the time window
         // (add possible time warp)
-        rTimeWarp += std::max(time - params->clients[0].twLate, 0);
+        rTimeWarp += std::max(time - params->twLate(0), 0);
 
         // Whole solution stats
-        distance += rDist;
+        distance_ += rDist;
         timeWarp += rTimeWarp;
         capacityExcess += std::max(load - params->vehicleCapacity, 0);
     }
@@ -81,57 +77,57 @@ void Individual::evaluateCompleteCost()
 
 int Individual::brokenPairsDistance(Individual const *other) const
 {
+    auto const *tNeighbours = this->neighbours.data();
+    auto const *oNeighbours = other->neighbours.data();
     int dist = 0;
 
+    // The loop body is kept free of branches (note the use of bitwise rather
+    // than logical operators), so the compiler can vectorise this loop.
     for (int j = 1; j <= params->nbClients; j++)
     {
-        auto const [tPred, tSucc] = this->neighbours[j];
-        auto const [oPred, oSucc] = other->neighbours[j];
+        auto const [tPred, tSucc] = tNeighbours[j];
+        auto const [oPred, oSucc] = oNeighbours[j];
 
         // Increase the difference if the successor of j in this individual is
         // not directly linked to j in other
-        dist += tSucc != oSucc && tSucc != oPred;
+        dist += (tSucc != oSucc) & (tSucc != oPred);
 
         // Increase the difference if the predecessor of j in this individual is
         // not directly linked to j in other
-        dist += tPred == 0 && oPred != 0 && oSucc != 0;
+        dist += (tPred == 0) & (oPred != 0) & (oSucc != 0);
     }
 
     return dist;
 }
 
-void Individual::registerNearbyIndividual(Individual *other)
+Individual::Routes Individual::getOriginalRoutes() const
 {
-    auto const dist = brokenPairsDistance(other);
-    auto cmp = [](auto &elem, auto &value) { return elem.first < value; };
+    Routes routes(params->nbVehicles);
 
-    auto &oProx = other->indivsByProximity;
-    auto place = std::lower_bound(oProx.begin(), oProx.end(), dist, cmp);
-    oProx.emplace(place, dist, this);
+    for (size_t rIdx = 0; rIdx != nbRoutes; ++rIdx)
+        for (auto const client : getRoutes()[rIdx])
+            routes[rIdx].push_back(params->originalId(client));
 
-    auto &tProx = this->indivsByProximity;
-    place = std::lower_bound(tProx.begin(), tProx.end(), dist, cmp);
-    tProx.emplace(place, dist, other);
+    return routes;
 }
 
-double Individual::avgBrokenPairsDistanceClosest() const
+std::vector<std::pair<int, int>> Individual::getOriginalNeighbours() const
 {
-    if (indivsByProximity.empty())
-        return 0.;
-
-    auto maxSize = std::min(params->config.nbClose, indivsByProximity.size());
-    auto start = indivsByProximity.begin();
-    int result = 0;
+    std::vector<std::pair<int, int>> original(neighbours.size());
 
-    for (auto it = start; it != start + maxSize; ++it)
-        result += it->first;
+    for (size_t client = 0; client != neighbours.size(); ++client)
+    {
+        auto const [pred, succ] = neighbours[client];
+        original[params->originalId(static_cast<int>(client))]
+            = {params->originalId(pred), params->originalId(succ)};
+    }
 
-    // Normalise broken pairs distance by # of clients and close neighbours
-    auto const numClose = static_cast<double>(maxSize);
-    return result / (params->nbClients * numClose);
+    return original;
 }
 
-void Individual::exportCVRPLibFormat(std::string const &path, double time) const
+void Individual::exportCVRPLibFormat(std::string const &path,
+                                     double time,
+                                     CostEvaluator const &costEvaluator) const
 {
     std::ofstream out(path);
 
@@ -139,89 +135,96 @@ void Individual::exportCVRPLibFormat(std::string const &path, double time) const
         throw std::runtime_error("Could not open " + path);
 
     out << *this;
+    out << "Cost " << cost(costEvaluator) << '\n';
     out << "Time " << time << '\n';
 }
 
+void Individual::setup()
+{
+    // Empty routes have equal start and end offsets, so removing duplicate
+    // offsets removes the empty routes.
+    offsets_.erase(std::unique(offsets_.begin(), offsets_.end()),
+                   offsets_.end());
+
+    nbRoutes = offsets_.size() - 1;
+
+    makeNeighbours();
+    evaluateCompleteCost();
+}
+
 void Individual::makeNeighbours()
 {
     neighbours[0] = {0, 0};  // note that depot neighbours have no meaning
 
-    for (auto const &route : routes_)
+    auto const routes = getRoutes();
+
+    for (size_t rIdx = 0; rIdx != nbRoutes; ++rIdx)
+    {
+        auto const route = routes[rIdx];
+
         for (size_t idx = 0; idx != route.size(); ++idx)
             neighbours[route[idx]]
                 = {idx == 0 ? 0 : route[idx - 1],                  // pred
                    idx == route.size() - 1 ? 0 : route[idx + 1]};  // succ
+    }
 }
 
 Individual::Individual(Params const *params, XorShift128 *rng)
     : params(params),
-      routes_(params->nbVehicles),
+      clients_(params->nbClients),
       neighbours(params->nbClients + 1)
 {
     auto const nbClients = params->nbClients;
     auto const nbVehicles = params->nbVehicles;
 
     // Sort clients randomly
-    auto clients = std::vector<int>(nbClients);
-    std::iota(clients.begin(), clients.end(), 1);
-    std::shuffle(clients.begin(), clients.end(), *rng);
+    std::iota(clients_.begin(), clients_.end(), 1);
+    std::shuffle(clients_.begin(), clients_.end(), *rng);
 
     // Distribute clients evenly over the routes
     auto const clientsPerRoute
         = std::max(nbClients / nbVehicles, 1) + (nbClients % nbVehicles != 0);
 
-    for (auto idx = 0; idx != params->nbClients; ++idx)
-    {
-        auto const client = clients[idx];
-        routes_[idx / clientsPerRoute].push_back(client);
-    }
+    for (auto idx = 0; idx < nbClients; idx += clientsPerRoute)
+        offsets_.push_back(idx);
 
-    makeNeighbours();
-    evaluateCompleteCost();
+    offsets_.push_back(nbClients);
+
+    setup();
 }
 
-Individual::Individual(Params const *params, Routes routes)
-    : params(params),
-      routes_(std::move(routes)),
-      neighbours(params->nbClients + 1)
+Individual::Individual(Params const *params, Routes const &routes)
+    : params(params), neighbours(params->nbClients + 1)
 {
-    // a precedes b only when a is not empty and b is. Combined with a stable
-    // sort, this ensures we keep the original sorting as much as possible, but
-    // also make sure all empty routes are at the end of routes_.
-    auto comp = [](auto &a, auto &b) { return !a.empty() && b.empty(); };
-    std::stable_sort(routes_.begin(), routes_.end(), comp);
+    // Non-empty routes keep their order, but all empty routes are removed.
+    // Those are implicitly at the end of the routes.
+    clients_.reserve(params->nbClients);
+    offsets_.reserve(routes.size() + 1);
+    offsets_.push_back(0);
 
-    makeNeighbours();
-    evaluateCompleteCost();
-}
+    for (auto const &route : routes)
+    {
+        clients_.insert(clients_.end(), route.begin(), route.end());
+        offsets_.push_back(clients_.size());
+    }
 
-Individual::Individual(Individual const &other)  // copy relevant route and cost
-    : nbRoutes(other.nbRoutes),                  // fields from other individual
-      distance(other.distance),                  // - but *not* the proximity
-      capacityExcess(other.capacityExcess),      // structure since the copy
-      timeWarp(other.timeWarp),                  // is not yet part of the same
-      params(other.params),                      // population.
-      routes_(other.routes_),
-      neighbours(other.neighbours)
-{
+    setup();
 }
 
-Individual::~Individual()
+Individual::Individual(Params const *params,
+                       std::vector<Client> clients,
+                       std::vector<size_t> offsets)
+    : params(params),
+      clients_(std::move(clients)),
+      offsets_(std::move(offsets)),
+      neighbours(params->nbClients + 1)
 {
-    for (auto [dist, other] : indivsByProximity)
-    {
-        auto place = std::find(other->indivsByProximity.begin(),
-                               other->indivsByProximity.end(),
-                               std::make_pair(dist, this));
-
-        if (place != other->indivsByProximity.end())
-            other->indivsByProximity.erase(place);
-    }
+    setup();
 }
 
 std::ostream &operator<<(std::ostream &out, Individual const &indiv)
 {
-    auto const &routes = indiv.getRoutes();
+    auto const routes = indiv.getOriginalRoutes();
 
     for (size_t rIdx = 0; rIdx != indiv.numRoutes(); ++rIdx)
     {
@@ -231,6 +234,5 @@ std::ostream &operator<<(std::ostream &out, Individual const &indiv)
         out << '\n';
     }
 
-    out << "Cost " << indiv.cost() << '\n';
     return out;
 }
@@ -1,14 +1,18 @@
 #include "LocalSearch.h"
 
+#include "InUseGuard.h"
 #include "Individual.h"
 #include "Params.h"
+#include "TaskScheduler.h"
 
 #include <numeric>
 #include <stdexcept>
+#include <tuple>
 #include <vector>
 
-void LocalSearch::search(Individual &indiv)
+void LocalSearch::search(Individual &indiv, CostEvaluator const &costEvaluator)
 {
+    InUseGuard guard(inUse, "LocalSearch");
     loadIndividual(indiv);
 
     // Shuffling the order beforehand adds diversity to the search
@@ -22,7 +26,11 @@ void LocalSearch::search(Individual &indiv)
     // track this). The lastModified field, in contrast, track when a route was
     // last *actually* modified.
     std::vector<int> lastTestedNodes(params.nbClients + 1, -1);
-    lastModified = std::vector<int>(params.nbVehicles, 0);
+
+    // Only the active routes need resetting: an empty route's lastModified
+    // is set when a move first inserts clients into it.
+    for (size_t idx = 0; idx != nbActiveRoutes; ++idx)
+        lastModified[routesByUse[idx]] = 0;
 
     searchCompleted = false;
     nbMoves = 0;
@@ -47,10 +55,11 @@ void LocalSearch::search(Individual &indiv)
                 if (lastModified[U->route->idx] > lastTestedNode
                     || lastModified[V->route->idx] > lastTestedNode)
                 {
-                    if (applyNodeOps(U, V))
+                    if (applyNodeOps(U, V, costEvaluator))
                         continue;
 
-                    if (p(V)->isDepot() && applyNodeOps(U, p(V)))
+                    if (p(V)->isDepot()
+                        && applyNodeOps(U, p(V), costEvaluator))
                         continue;
                 }
             }
@@ -59,13 +68,12 @@ void LocalSearch::search(Individual &indiv)
             // increasing the fleet size too much.
             if (step > 0)
             {
-                auto pred = [](auto const &route) { return route.empty(); };
-                auto empty = std::find_if(routes.begin(), routes.end(), pred);
-
-                if (empty == routes.end())
+                if (nbActiveRoutes == routesByUse.size())  // no empty route
                     continue;
 
-                if (applyNodeOps(U, empty->depot))
+                auto &empty = routes[routesByUse[nbActiveRoutes]];
+
+                if (applyNodeOps(U, empty.depot, costEvaluator))
                     continue;
             }
         }
@@ -74,20 +82,36 @@ void LocalSearch::search(Individual &indiv)
     indiv = exportIndividual();
 }
 
-void LocalSearch::intensify(Individual &indiv)
+void LocalSearch::intensify(Individual &indiv,
+                            CostEvaluator const &costEvaluator)
 {
+    InUseGuard guard(inUse, "LocalSearch");
     loadIndividual(indiv);
 
     // Shuffling the order beforehand adds diversity to the search
+    // Route operators do not move clients into empty routes, so only the
+    // routes that are active now can take part in the intensification.
+    orderRoutes.assign(routesByUse.begin(),
+                       routesByUse.begin() + nbActiveRoutes);
+
     std::shuffle(orderRoutes.begin(), orderRoutes.end(), rng);
     std::shuffle(routeOps.begin(), routeOps.end(), rng);
 
-    std::vector<int> lastTestedRoutes(params.nbVehicles, -1);
-    lastModified = std::vector<int>(params.nbVehicles, 0);
+    for (int const r : orderRoutes)
+        lastModified[r] = 0;
 
     searchCompleted = false;
     nbMoves = 0;
 
+    if (params.config.parallelIntensify)
+    {
+        intensifyParallel(costEvaluator);
+        indiv = exportIndividual();
+        return;
+    }
+
+    std::vector<int> lastTestedRoutes(params.nbVehicles, -1);
+
     while (!searchCompleted)
     {
         searchCompleted = true;
@@ -102,34 +126,188 @@ void LocalSearch::intensify(Individual &indiv)
             auto const lastTested = lastTestedRoutes[U.idx];
             lastTestedRoutes[U.idx] = nbMoves;
 
-            // Shuffling in this loop should not matter much as we are
-            // already randomizing the routes U.
-            for (int rV = 0; rV != U.idx; ++rV)
+            // Each pair is evaluated once, from the route with the larger
+            // index.
+            for (int const rV : orderRoutes)
             {
                 auto &V = routes[rV];
 
-                if (V.empty())
+                if (V.idx >= U.idx || V.empty() || !sectorsOverlap(U, V))
                     continue;
 
                 auto const lastModifiedRoute
                     = std::max(lastModified[U.idx], lastModified[V.idx]);
 
-                if (lastModifiedRoute > lastTested && applyRouteOps(&U, &V))
+                if (lastModifiedRoute > lastTested
+                    && applyRouteOps(&U, &V, costEvaluator))
                     continue;
             }
 
             if (lastModified[U.idx] > lastTested)
-                enumerateSubpaths(U);
+                enumerateSubpaths(U, costEvaluator);
         }
     }
 
     indiv = exportIndividual();
 }
 
-bool LocalSearch::applyNodeOps(Node *U, Node *V)
+void LocalSearch::intensifyParallel(CostEvaluator const &costEvaluator)
+{
+    struct Move
+    {
+        int deltaCost;
+        size_t pair;  // index into the route pairs of this round
+        size_t op;    // index into the route operators
+    };
+
+    std::vector<int> lastEnumerated(params.nbVehicles, -1);
+    int lastRound = -1;  // nbMoves at the start of the previous round
+
+    auto const scheduler = TaskScheduler::shared();
+
+    while (!searchCompleted)
+    {
+        searchCompleted = true;
+
+        // Only pairs with a route that changed in the previous round need to
+        // be evaluated. Other pairs did not have an improving move then, or
+        // their moves conflicted with a move that changed one of their routes.
+        std::vector<std::pair<Route *, Route *>> pairs;
+
+        for (int const rU : orderRoutes)
+        {
+            auto &U = routes[rU];
+
+            if (U.empty())
+                continue;
+
+            for (int const rV : orderRoutes)
+            {
+                auto &V = routes[rV];
+
+                if (V.idx < U.idx && !V.empty() && sectorsOverlap(U, V)
+                    && std::max(lastModified[U.idx], lastModified[V.idx])
+                           > lastRound)
+                    pairs.emplace_back(&U, &V);
+            }
+        }
+
+        // The routes that take part and the operators' caches for them are
+        // first brought up to date, so that the pairs can be evaluated
+        // concurrently.
+        std::vector<bool> prepared(params.nbVehicles, false);
+
+        for (auto const &[U, V] : pairs)
+            for (auto *route : {U, V})
+                if (!prepared[route->idx])
+                {
+                    prepared[route->idx] = true;
+                    route->updateBlocks();
+
+                    for (auto *op : routeOps)
+                        op->prepare(route, costEvaluator);
+                }
+
+        // Pairs are divided over at most one chunk per scheduler thread. The
+        // first chunk uses the route operators themselves, the other chunks
+        // get scratch operators that share the operators' caches. Each pair
+        // records the first operator that finds an improving move.
+        auto const nbChunks = std::max<size_t>(
+            std::min(scheduler->numThreads(), pairs.size()), 1);
+
+        std::vector<std::vector<std::unique_ptr<RouteOp>>> scratch(nbChunks);
+        for (size_t chunk = 1; chunk != nbChunks; ++chunk)
+            for (auto *op : routeOps)
+                scratch[chunk].push_back(op->scratch());
+
+        std::vector<std::vector<Move>> improving(nbChunks);
+
+        scheduler->parallelFor(nbChunks, [&](size_t chunk) {
+            for (auto idx = chunk; idx < pairs.size(); idx += nbChunks)
+                for (size_t op = 0; op != routeOps.size(); ++op)
+                {
+                    auto *routeOp
+                        = chunk == 0 ? routeOps[op] : scratch[chunk][op].get();
+
+                    auto const [U, V] = pairs[idx];
+                    auto const deltaCost
+                        = routeOp->evaluate(U, V, costEvaluator);
+
+                    if (deltaCost < 0)
+                    {
+                        improving[chunk].push_back({deltaCost, idx, op});
+                        break;
+                    }
+                }
+        });
+
+        std::vector<Move> moves;
+        for (auto const &threadMoves : improving)
+            moves.insert(moves.end(), threadMoves.begin(), threadMoves.end());
+
+        auto const cmp = [](auto const &move1, auto const &move2) {
+            return std::tie(move1.deltaCost, move1.pair)
+                   < std::tie(move2.deltaCost, move2.pair);
+        };
+
+        std::sort(moves.begin(), moves.end(), cmp);
+
+        // Greedily apply the most improving moves, as long as they do not touch
+        // a route that is already changed in this round.
+        auto const roundStart = nbMoves;
+        std::vector<bool> touched(params.nbVehicles, false);
+
+        for (auto const &move : moves)
+        {
+            auto const [U, V] = pairs[move.pair];
+
+            if (touched[U->idx] || touched[V->idx])
+                continue;
+
+            touched[U->idx] = true;
+            touched[V->idx] = true;
+
+            // The move's evaluation depends only on routes U and V, which have
+            // not changed since. Evaluating it again prepares the operator to
+            // apply the move.
+            auto *op = routeOps[move.op];
+
+            if (op->evaluate(U, V, costEvaluator) < 0)
+            {
+                op->apply(U, V);
+                update(U, V);
+            }
+        }
+
+        for (int const rU : orderRoutes)
+        {
+            auto &U = routes[rU];
+
+            if (!U.empty() && lastModified[U.idx] > lastEnumerated[U.idx])
+            {
+                lastEnumerated[U.idx] = nbMoves;
+                enumerateSubpaths(U, costEvaluator);
+            }
+        }
+
+        lastRound = roundStart;
+    }
+}
+
+bool LocalSearch::sectorsOverlap(Route const &U, Route const &V) const
+{
+    // Routes in separate parts of the plane rarely have improving moves
+    // between them, so such pairs are skipped when the filter is enabled.
+    return !params.config.circleSectorFilter
+           || U.sector().overlaps(V.sector());
+}
+
+bool LocalSearch::applyNodeOps(Node *U,
+                               Node *V,
+                               CostEvaluator const &costEvaluator)
 {
     for (auto op : nodeOps)
-        if (op->evaluate(U, V) < 0)
+        if (op->evaluate(U, V, costEvaluator) < 0)
         {
             auto *routeU = U->route;  // copy pointers because the operator can
             auto *routeV = V->route;  // modify the node's route membership
@@ -143,10 +321,12 @@ bool LocalSearch::applyNodeOps(Node *U, Node *V)
     return false;
 }
 
-bool LocalSearch::applyRouteOps(Route *U, Route *V)
+bool LocalSearch::applyRouteOps(Route *U,
+                                Route *V,
+                                CostEvaluator const &costEvaluator)
 {
     for (auto op : routeOps)
-        if (op->evaluate(U, V) < 0)
+        if (op->evaluate(U, V, costEvaluator) < 0)
         {
             op->apply(U, V);
             update(U, V);
@@ -163,6 +343,7 @@ void LocalSearch::update(Route *U, Route *V)
     searchCompleted = false;
 
     U->update();
+    updateActiveRoutes(*U);
     lastModified[U->idx] = nbMoves;
 
     for (auto op : routeOps)  // TODO only route operators use this (SWAP*).
@@ -171,6 +352,7 @@ void LocalSearch::update(Route *U, Route *V)
     if (U != V)
     {
         V->update();
+        updateActiveRoutes(*V);
         lastModified[V->idx] = nbMoves;
 
         for (auto op : routeOps)
@@ -178,55 +360,177 @@ void LocalSearch::update(Route *U, Route *V)
     }
 }
 
+void LocalSearch::updateActiveRoutes(Route const &route)
+{
+    auto const pos = routePositions[route.idx];
+    auto const isActive = pos < nbActiveRoutes;
+
+    if (route.empty() == !isActive)  // route is already in the right list
+        return;
+
+    // The boundary between the active and free lists is at nbActiveRoutes.
+    // Swapping the route with the route at that boundary and moving the
+    // boundary moves the route into the other list.
+    auto const boundary = isActive ? --nbActiveRoutes : nbActiveRoutes++;
+    auto const other = routesByUse[boundary];
+
+    std::swap(routesByUse[pos], routesByUse[boundary]);
+    routePositions[other] = pos;
+    routePositions[route.idx] = boundary;
+}
+
 // TODO this should be some sort of operator passed into LS, it should not be
 //  defined here.
-void LocalSearch::enumerateSubpaths(Route &U)
+void LocalSearch::enumerateSubpaths(Route &U,
+                                    CostEvaluator const &costEvaluator)
 {
     auto const k = std::min(params.config.postProcessPathLength, U.size());
 
     if (k <= 1)  // 0 or 1 means we are either not doing anything at all (0),
         return;  // or recombining a single node (1). Neither helps.
 
+    auto const &distMat = params.distanceMatrix();
+    auto const fullSet = (size_t(1) << k) - 1;
+
     std::vector<size_t> path(k);
+    labelsByState.resize((fullSet + 1) * k);
+
+    // Adds the label to the given state, unless it is dominated by one of the
+    // state's labels. Labels of the state that it dominates are removed.
+    auto const addLabel = [&](size_t state, SubpathLabel const &label) {
+        auto &stateLabels = labelsByState[state];
+
+        for (auto const idx : stateLabels)
+            if (labels[idx].dist <= label.dist
+                && labels[idx].tws.dominates(label.tws))
+                return;
+
+        std::erase_if(stateLabels, [&](auto idx) {
+            return label.dist <= labels[idx].dist
+                   && label.tws.dominates(labels[idx].tws);
+        });
+
+        stateLabels.push_back(labels.size());
+        labels.push_back(label);
+    };
 
     // This postprocessing step optimally recombines all node segments of a
-    // given length in each route. This recombination works by enumeration; see
-    // issue #98 for details.
+    // given length in each route; see issue #98 for details.
     for (size_t start = 1; start + k <= U.size() + 1; ++start)
     {
         auto *prev = p(U[start]);   // we process [start, start + k). So fixed
         auto *next = U[start + k];  // endpoints are p(start) and start + k
 
         std::iota(path.begin(), path.end(), start);
-        auto currCost = evaluateSubpath(path, prev, next, U);
-
-        while (std::next_permutation(path.begin(), path.end()))
+        auto const currCost
+            = evaluateSubpath(path, prev, next, U, costEvaluator);
+
+        // A partial path's distance and time warp never decrease when it is
+        // extended, so partial paths that are not cheaper than the current
+        // order cannot lead to an improving order.
+        auto const canImprove = [&](SubpathLabel const &label) {
+            auto const timeWarp = label.tws.segmentTimeWarp();
+            return label.dist + costEvaluator.twPenalty(timeWarp) < currCost;
+        };
+
+        labels.clear();
+        for (auto &stateLabels : labelsByState)
+            stateLabels.clear();
+
+        for (size_t idx = 0; idx != k; ++idx)
         {
-            auto const cost = evaluateSubpath(path, prev, next, U);
+            auto const *node = U[start + idx];
+            auto const tws
+                = TimeWindowSegment::merge(distMat, prev->twBefore(), node->tw);
+            auto const dist = params.dist(prev->client, node->client);
+            SubpathLabel const label = {dist, tws, idx, labels.size()};
+
+            if (canImprove(label))
+                addLabel((size_t(1) << idx) * k + idx, label);
+        }
 
-            if (cost < currCost)
+        // Subsets are processed in increasing order, so all subsets of a set
+        // are done before the set itself is extended.
+        for (size_t set = 1; set != fullSet; ++set)
+            for (size_t last = 0; last != k; ++last)
             {
-                for (auto pos : path)
+                // Labels are only added to larger sets, so this loop does not
+                // invalidate the current state's labels.
+                for (auto const labelIdx : labelsByState[set * k + last])
+                    for (size_t idx = 0; idx != k; ++idx)
+                    {
+                        if (set & (size_t(1) << idx))
+                            continue;
+
+                        auto const from = U[start + labels[labelIdx].last];
+                        auto const *to = U[start + idx];
+                        SubpathLabel const label
+                            = {labels[labelIdx].dist
+                                   + params.dist(from->client, to->client),
+                               TimeWindowSegment::merge(
+                                   distMat, labels[labelIdx].tws, to->tw),
+                               idx,
+                               labelIdx};
+
+                        if (canImprove(label))
+                        {
+                            auto const newSet = set | (size_t(1) << idx);
+                            addLabel(newSet * k + idx, label);
+                        }
+                    }
+            }
+
+        auto bestCost = currCost;
+        auto bestLabel = labels.size();
+
+        for (size_t last = 0; last != k; ++last)
+            for (auto const labelIdx : labelsByState[fullSet * k + last])
+            {
+                auto const &label = labels[labelIdx];
+                auto const *lastNode = U[start + last];
+                auto const tws = TimeWindowSegment::merge(
+                    distMat, label.tws, next->twAfter());
+                auto const dist = params.dist(lastNode->client, next->client);
+                auto const timeWarp = tws.totalTimeWarp();
+                auto const cost
+                    = label.dist + dist + costEvaluator.twPenalty(timeWarp);
+
+                if (cost < bestCost)
                 {
-                    auto *node = U[pos];
-                    node->insertAfter(prev);
-                    prev = node;
+                    bestCost = cost;
+                    bestLabel = labelIdx;
                 }
-
-                update(&U, &U);  // it is rare to find more than one improving
-                break;           // move, so we break after the first
             }
+
+        if (bestLabel == labels.size())  // no improving order exists
+            continue;
+
+        // Follow the parent labels to recover the best order. The labels
+        // visit the order back to front.
+        auto labelIdx = bestLabel;
+        for (auto pos = k; pos-- != 0; labelIdx = labels[labelIdx].parent)
+            path[pos] = start + labels[labelIdx].last;
+
+        for (auto pos : path)
+        {
+            auto *node = U[pos];
+            node->insertAfter(prev);
+            prev = node;
         }
+
+        update(&U, &U);
     }
 }
 
 int LocalSearch::evaluateSubpath(std::vector<size_t> const &subpath,
                                  Node const *before,
                                  Node const *after,
-                                 Route const &route) const
+                                 Route const &route,
+                                 CostEvaluator const &costEvaluator) const
 {
+    auto const &distMat = params.distanceMatrix();
     auto totalDist = 0;
-    auto tws = before->twBefore;
+    auto tws = before->twBefore();
     auto from = before->client;
 
     // Calculates travel distance and time warp of the subpath permutation.
@@ -235,32 +539,29 @@ int LocalSearch::evaluateSubpath(std::vector<size_t> const &subpath,
         auto *to = route[pos];
 
         totalDist += params.dist(from, to->client);
-        tws = TimeWindowSegment::merge(tws, to->tw);
+        tws = TimeWindowSegment::merge(distMat, tws, to->tw);
         from = to->client;
     }
 
     totalDist += params.dist(from, after->client);
-    tws = TimeWindowSegment::merge(tws, after->twAfter);
+    tws = TimeWindowSegment::merge(distMat, tws, after->twAfter());
 
-    return totalDist + params.twPenalty(tws.totalTimeWarp());
+    return totalDist + costEvaluator.twPenalty(tws.totalTimeWarp());
 }
 
 void LocalSearch::loadIndividual(Individual const &indiv)
 {
-    for (int client = 0; client <= params.nbClients; client++)
-        clients[client].tw = {&params,
-                              client,
-                              client,
-                              params.clients[client].servDur,
-                              0,
-                              params.clients[client].twEarly,
-                              params.clients[client].twLate,
-                              params.clients[client].releaseTime};
-
     auto const &routesIndiv = indiv.getRoutes();
+    auto const nbRoutes = indiv.numRoutes();
+
+    // The individual's non-empty routes are loaded into the routes at the
+    // front of routesByUse. Any further routes that were active for the
+    // previous individual are emptied. All other routes are already empty.
+    auto const nbLoaded = std::max(nbRoutes, nbActiveRoutes);
 
-    for (int r = 0; r < params.nbVehicles; r++)
+    for (size_t idx = 0; idx != nbLoaded; ++idx)
     {
+        auto const r = routesByUse[idx];
         Node *startDepot = &startDepots[r];
         Node *endDepot = &endDepots[r];
 
@@ -270,29 +571,22 @@ void LocalSearch::loadIndividual(Individual const &indiv)
         endDepot->prev = startDepot;
         endDepot->next = startDepot;
 
-        startDepot->tw = clients[0].tw;
-        startDepot->twBefore = clients[0].tw;
-        startDepot->twAfter = clients[0].tw;
-
-        endDepot->tw = clients[0].tw;
-        endDepot->twBefore = clients[0].tw;
-        endDepot->twAfter = clients[0].tw;
-
         Route *route = &routes[r];
+        auto const routeIndiv = routesIndiv[idx];
 
-        if (!routesIndiv[r].empty())
+        if (!routeIndiv.empty())
         {
-            Node *client = &clients[routesIndiv[r][0]];
+            Node *client = &clients[routeIndiv[0]];
             client->route = route;
 
             client->prev = startDepot;
             startDepot->next = client;
 
-            for (int i = 1; i < static_cast<int>(routesIndiv[r].size()); i++)
+            for (size_t i = 1; i < routeIndiv.size(); i++)
             {
                 Node *prev = client;
 
-                client = &clients[routesIndiv[r][i]];
+                client = &clients[routeIndiv[i]];
                 client->route = route;
 
                 client->prev = prev;
@@ -306,6 +600,8 @@ void LocalSearch::loadIndividual(Individual const &indiv)
         route->update();
     }
 
+    nbActiveRoutes = nbRoutes;
+
     for (auto op : nodeOps)
         op->init(indiv);
 
@@ -316,39 +612,51 @@ void LocalSearch::loadIndividual(Individual const &indiv)
 Individual LocalSearch::exportIndividual()
 {
     std::vector<std::pair<double, int>> routePolarAngles;
-    routePolarAngles.reserve(params.nbVehicles);
+    routePolarAngles.reserve(nbActiveRoutes);
 
-    for (int r = 0; r < params.nbVehicles; r++)
+    for (size_t idx = 0; idx != nbActiveRoutes; ++idx)
+    {
+        auto const r = routesByUse[idx];
         routePolarAngles.emplace_back(routes[r].angleCenter, r);
+    }
 
-    // Empty routes have a large center angle, and thus always sort at the end
     std::sort(routePolarAngles.begin(), routePolarAngles.end());
 
-    std::vector<std::vector<int>> indivRoutes(params.nbVehicles);
+    // The routes are stored back to back, as expected by Individual.
+    std::vector<int> indivClients;
+    indivClients.reserve(params.nbClients);
 
-    for (int r = 0; r < params.nbVehicles; r++)
+    std::vector<size_t> offsets;
+    offsets.reserve(nbActiveRoutes + 1);
+    offsets.push_back(0);
+
+    for (auto const &[angle, r] : routePolarAngles)
     {
-        Node *node = startDepots[routePolarAngles[r].second].next;
+        Node *node = startDepots[r].next;
 
         while (!node->isDepot())
         {
-            indivRoutes[r].push_back(node->client);
+            indivClients.push_back(node->client);
             node = node->next;
         }
+
+        offsets.push_back(indivClients.size());
     }
 
-    return {&params, indivRoutes};
+    return {&params, std::move(indivClients), std::move(offsets)};
 }
 
-LocalSearch::LocalSearch(Params &params, XorShift128 &rng)
+LocalSearch::LocalSearch(Params const &params, XorShift128 &rng)
     : params(params),
       rng(rng),
       orderNodes(params.nbClients),
-      orderRoutes(params.nbVehicles),
-      lastModified(params.nbVehicles, -1)
+      lastModified(params.nbVehicles, -1),
+      routesByUse(params.nbVehicles),
+      routePositions(params.nbVehicles)
 {
     std::iota(orderNodes.begin(), orderNodes.end(), 1);
-    std::iota(orderRoutes.begin(), orderRoutes.end(), 0);
+    std::iota(routesByUse.begin(), routesByUse.end(), 0);
+    std::iota(routePositions.begin(), routePositions.end(), 0);
 
     clients = std::vector<Node>(params.nbClients + 1);
     routes = std::vector<Route>(params.nbVehicles);
@@ -359,8 +667,17 @@ LocalSearch::LocalSearch(Params &params, XorShift128 &rng)
     {
         clients[i].params = &params;
         clients[i].client = i;
+        clients[i].tw = {i,
+                         i,
+                         params.servDur(i),
+                         0,
+                         params.twEarly(i),
+                         params.twLate(i),
+                         params.releaseTime(i)};
     }
 
+    // All routes start out empty. Routes are only reset when they are used
+    // by an individual, so the other routes remain empty from here on.
     for (int i = 0; i < params.nbVehicles; i++)
     {
         routes[i].params = &params;
@@ -370,9 +687,33 @@ LocalSearch::LocalSearch(Params &params, XorShift128 &rng)
         startDepots[i].params = &params;
         startDepots[i].client = 0;
         startDepots[i].route = &routes[i];
+        startDepots[i].tw = clients[0].tw;
+        startDepots[i].prev = &endDepots[i];
+        startDepots[i].next = &endDepots[i];
 
-        startDepots[i].params = &params;
+        endDepots[i].params = &params;
         endDepots[i].client = 0;
         endDepots[i].route = &routes[i];
+        endDepots[i].tw = clients[0].tw;
+        endDepots[i].prev = &startDepots[i];
+        endDepots[i].next = &startDepots[i];
+
+        routes[i].update();
+    }
+}
+
+LocalSearch::LocalSearch(LocalSearch const &other, XorShift128 &rng)
+    : LocalSearch(other.params, rng)
+{
+    for (auto const *op : other.nodeOps)
+    {
+        ownedNodeOps.push_back(op->clone(params));
+        addNodeOperator(*ownedNodeOps.back());
+    }
+
+    for (auto const *op : other.routeOps)
+    {
+        ownedRouteOps.push_back(op->clone(params));
+        addRouteOperator(*ownedRouteOps.back());
     }
 }
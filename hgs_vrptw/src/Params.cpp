@@ -1,15 +1,64 @@
 #include "Params.h"
 
+#include "CircleSector.h"
 #include "Matrix.h"
+#include "TaskScheduler.h"
 #include "XorShift128.h"
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <fstream>
-#include <set>
+#include <numeric>
 #include <string>
 #include <vector>
 
+namespace
+{
+// Order of the Hilbert curve used to renumber clients: coordinates are scaled
+// to a grid of 2^order by 2^order cells.
+constexpr uint32_t CURVE_ORDER = 16;
+
+// Scales the given coordinate from [min, max] to a cell of the curve's grid.
+uint32_t scaleCoordinate(int coord, int min, int max)
+{
+    if (max == min)
+        return 0;
+
+    auto const cells = (uint64_t(1) << CURVE_ORDER) - 1;
+    return static_cast<uint32_t>(uint64_t(coord - min) * cells / (max - min));
+}
+
+// Returns the position of the given grid cell along the Hilbert curve.
+uint64_t hilbertIndex(uint32_t x, uint32_t y)
+{
+    uint32_t const last = (uint32_t(1) << CURVE_ORDER) - 1;
+    uint64_t idx = 0;
+
+    for (uint32_t size = uint32_t(1) << (CURVE_ORDER - 1); size > 0; size /= 2)
+    {
+        uint32_t const rx = (x & size) != 0;
+        uint32_t const ry = (y & size) != 0;
+        idx += uint64_t(size) * size * ((3 * rx) ^ ry);
+
+        // Rotate the quadrant, so the curve's sub-pattern is in its standard
+        // orientation.
+        if (ry == 0)
+        {
+            if (rx == 1)
+            {
+                x = last - x;
+                y = last - y;
+            }
+
+            std::swap(x, y);
+        }
+    }
+
+    return idx;
+}
+}  // namespace
+
 Params::Params(Config const &config, std::string const &instPath)
     : config(config)
 {
@@ -21,6 +70,7 @@ Params::Params(Config const &config, std::string const &instPath)
     nbClients = 0;
     int totalDemand = 0;
     int maxDemand = 0;
+    Matrix<int> distances;
     vehicleCapacity = INT_MAX;
 
     // Read INPUT dataset
@@ -143,14 +193,14 @@ Params::Params(Config const &config, std::string const &instPath)
             // Read the edge weights of an explicit distance matrix
             else if (content == "EDGE_WEIGHT_SECTION")
             {
-                dist_ = Matrix<int>(nbClients + 1);
+                distances = Matrix<int>(nbClients + 1);
                 for (int i = 0; i <= nbClients; i++)
                 {
                     for (int j = 0; j <= nbClients; j++)
                     {
                         // Keep track of the largest distance between two
                         // clients (or the depot)
-                        inputFile >> dist(i, j);
+                        inputFile >> distances(i, j);
                     }
                 }
             }
@@ -304,7 +354,10 @@ Params::Params(Config const &config, std::string const &instPath)
     }
 
     nbVehicles = config.nbVeh >= nbClients ? nbClients : config.nbVeh;
-    maxDist_ = dist_.max();
+    renumberClients(distances);
+    storeClientFields();
+    maxDist_ = distances.max();
+    dist_ = DistanceMatrix(distances);
 
     // Calculate, for all vertices, the correlation for the nbGranular closest
     // vertices
@@ -330,12 +383,6 @@ Params::Params(Config const &config, std::string const &instPath)
         throw std::runtime_error(
             "Fleet size is insufficient to service the considered clients.");
     }
-
-    // A reasonable scale for the initial values of the penalties
-    penaltyCapacity = std::max(1, std::min(1000, maxDist_ / maxDemand));
-
-    // Initial parameter values of this parameter is not argued
-    penaltyTimeWarp = static_cast<int>(config.initialTimeWarpPenalty);
 }
 
 Params::Params(Config const &config,
@@ -351,21 +398,11 @@ Params::Params(Config const &config,
       nbVehicles(std::max(std::min(config.nbVeh, nbClients), 1)),
       vehicleCapacity(vehicleCap)
 {
-    dist_ = Matrix<int>(distMat.size());
+    Matrix<int> distances(distMat.size());
 
     for (size_t i = 0; i != distMat.size(); ++i)
         for (size_t j = 0; j != distMat[i].size(); ++j)
-            dist(i, j) = distMat[i][j];
-
-    maxDist_ = dist_.max();
-
-    // A reasonable scale for the initial values of the penalties
-    int const maxDemand = *std::max_element(demands.begin(), demands.end());
-    int const initCapPenalty = maxDist_ / std::max(maxDemand, 1);
-    penaltyCapacity = std::max(std::min(1000, initCapPenalty), 1);
-
-    // Initial parameter values of this parameter is not argued
-    penaltyTimeWarp = static_cast<int>(config.initialTimeWarpPenalty);
+            distances(i, j) = distMat[i][j];
 
     clients = std::vector<Client>(nbClients + 1);
 
@@ -378,74 +415,153 @@ Params::Params(Config const &config,
                         timeWindows[idx].second,
                         releases[idx]};
 
+    renumberClients(distances);
+    storeClientFields();
+    maxDist_ = distances.max();
+    dist_ = DistanceMatrix(distances);
+
     calculateNeighbours();
 }
 
-void Params::calculateNeighbours()
+void Params::renumberClients(Matrix<int> &distances)
 {
-    auto proximities
-        = std::vector<std::vector<std::pair<int, int>>>(nbClients + 1);
+    originalIds = std::vector<int>(nbClients + 1);
+    std::iota(originalIds.begin(), originalIds.end(), 0);
 
-    for (int i = 1; i <= nbClients; i++)  // exclude depot
+    if (config.renumberClients && nbClients > 1)
     {
-        auto &proximity = proximities[i];
+        auto const [minX, maxX] = std::minmax_element(
+            clients.begin() + 1,
+            clients.begin() + nbClients + 1,
+            [](auto const &a, auto const &b) { return a.x < b.x; });
+
+        auto const [minY, maxY] = std::minmax_element(
+            clients.begin() + 1,
+            clients.begin() + nbClients + 1,
+            [](auto const &a, auto const &b) { return a.y < b.y; });
+
+        std::vector<uint64_t> curveIdx(nbClients + 1);
+        for (int client = 1; client <= nbClients; ++client)
+            curveIdx[client] = hilbertIndex(
+                scaleCoordinate(clients[client].x, minX->x, maxX->x),
+                scaleCoordinate(clients[client].y, minY->y, maxY->y));
 
-        for (int j = 1; j <= nbClients; j++)  // exclude depot
+        auto const byCurveIdx
+            = [&](int a, int b) { return curveIdx[a] < curveIdx[b]; };
+
+        std::stable_sort(
+            originalIds.begin() + 1, originalIds.end(), byCurveIdx);
+
+        std::vector<Client> renumbered(clients.size());
+        Matrix<int> renumberedDists(nbClients + 1);
+
+        for (int i = 0; i <= nbClients; ++i)
         {
-            if (i == j)  // exclude the current client
-                continue;
-
-            // Compute proximity using Eq. 4 in Vidal 2012. The proximity is
-            // computed by the distance, min. wait time and min. time warp
-            // going from either i -> j or j -> i, whichever is the least.
-            int const maxRelease
-                = std::max(clients[i].releaseTime, clients[j].releaseTime);
-
-            // Proximity from j to i
-            int const waitTime1 = clients[i].twEarly - dist(j, i)
-                                  - clients[j].servDur - clients[j].twLate;
-            int const earliestArrival1
-                = std::max(maxRelease + dist(0, j), clients[j].twEarly);
-            int const timeWarp1 = earliestArrival1 + clients[j].servDur
-                                  + dist(j, i) - clients[i].twLate;
-            int const prox1 = dist(j, i)
-                              + config.weightWaitTime * std::max(0, waitTime1)
-                              + config.weightTimeWarp * std::max(0, timeWarp1);
-
-            // Proximity from i to j
-            int const waitTime2 = clients[j].twEarly - dist(i, j)
-                                  - clients[i].servDur - clients[i].twLate;
-            int const earliestArrival2
-                = std::max(maxRelease + dist(0, i), clients[i].twEarly);
-            int const timeWarp2 = earliestArrival2 + clients[i].servDur
-                                  + dist(i, j) - clients[j].twLate;
-            int const prox2 = dist(i, j)
-                              + config.weightWaitTime * std::max(0, waitTime2)
-                              + config.weightTimeWarp * std::max(0, timeWarp2);
-
-            proximity.emplace_back(std::min(prox1, prox2), j);
+            renumbered[i] = clients[originalIds[i]];
+
+            for (int j = 0; j <= nbClients; ++j)
+                renumberedDists(i, j)
+                    = distances(originalIds[i], originalIds[j]);
         }
 
-        std::sort(proximity.begin(), proximity.end());
+        clients = std::move(renumbered);
+        distances = std::move(renumberedDists);
     }
 
-    neighbours = std::vector<std::vector<int>>(nbClients + 1);
+    internalIds = std::vector<int>(nbClients + 1);
+    for (int client = 0; client <= nbClients; ++client)
+        internalIds[originalIds[client]] = client;
+}
 
-    // First create a set of correlated vertices for each vertex (where the
-    // depot is not taken into account)
-    std::vector<std::set<int>> set(nbClients + 1);
-    size_t const granularity
-        = std::min(config.nbGranular, static_cast<size_t>(nbClients) - 1);
+void Params::storeClientFields()
+{
+    auto const store = [&](std::vector<int> &field, auto member) {
+        field.resize(clients.size());
+        for (size_t client = 0; client != clients.size(); ++client)
+            field[client] = clients[client].*member;
+    };
+
+    store(xs_, &Client::x);
+    store(ys_, &Client::y);
+    store(servDurs_, &Client::servDur);
+    store(demands_, &Client::demand);
+    store(twEarlies_, &Client::twEarly);
+    store(twLates_, &Client::twLate);
+    store(releaseTimes_, &Client::releaseTime);
+
+    angles_.resize(clients.size());
+    for (size_t client = 0; client != clients.size(); ++client)
+        angles_[client] = CircleSector::polarAngle(xs_[client] - xs_[0],
+                                                   ys_[client] - ys_[0]);
+}
 
-    for (int i = 1; i <= nbClients; i++)  // again exclude depot
-    {
-        auto const &orderProximity = proximities[i];
+void Params::calculateNeighbours()
+{
+    // Compute proximity using Eq. 4 in Vidal 2012. The proximity is computed
+    // by the distance, min. wait time and min. time warp going from either
+    // i -> j or j -> i, whichever is the least.
+    auto const proximity = [&](int i, int j) {
+        int const maxRelease = std::max(releaseTime(i), releaseTime(j));
+
+        // Proximity from j to i
+        int const waitTime1 = twEarly(i) - dist(j, i) - servDur(j) - twLate(j);
+        int const earliestArrival1
+            = std::max(maxRelease + dist(0, j), twEarly(j));
+        int const timeWarp1
+            = earliestArrival1 + servDur(j) + dist(j, i) - twLate(i);
+        int const prox1 = dist(j, i)
+                          + config.weightWaitTime * std::max(0, waitTime1)
+                          + config.weightTimeWarp * std::max(0, timeWarp1);
+
+        // Proximity from i to j
+        int const waitTime2 = twEarly(j) - dist(i, j) - servDur(i) - twLate(i);
+        int const earliestArrival2
+            = std::max(maxRelease + dist(0, i), twEarly(i));
+        int const timeWarp2
+            = earliestArrival2 + servDur(i) + dist(i, j) - twLate(j);
+        int const prox2 = dist(i, j)
+                          + config.weightWaitTime * std::max(0, waitTime2)
+                          + config.weightTimeWarp * std::max(0, timeWarp2);
+
+        return std::min(prox1, prox2);
+    };
+
+    nbNeighbours = nbClients > 1 ? std::min(config.nbGranular,
+                                            static_cast<size_t>(nbClients) - 1)
+                                 : 0;
+    neighbours = std::vector<int>(nbClients * nbNeighbours);
+
+    if (nbNeighbours == 0)
+        return;
+
+    auto const scheduler = TaskScheduler::shared();
+    auto const nbChunks = std::min(scheduler->numThreads(),
+                                   static_cast<size_t>(nbClients));
+
+    scheduler->parallelFor(nbChunks, [&](size_t chunk) {
+        // (proximity, client) pairs. Since the clients are unique, ties in
+        // proximity are broken by client index.
+        std::vector<std::pair<int, int>> proximities;
+        proximities.reserve(nbClients - 1);
+
+        for (auto i = static_cast<int>(chunk) + 1; i <= nbClients;
+             i += static_cast<int>(nbChunks))  // exclude depot
+        {
+            proximities.clear();
 
-        for (size_t j = 0; j != granularity; ++j)
-            set[i].insert(orderProximity[j].second);
-    }
+            for (int j = 1; j <= nbClients; j++)  // exclude depot
+                if (i != j)                       // and the current client
+                    proximities.emplace_back(proximity(i, j), j);
+
+            // We only need the nbNeighbours closest clients, not a full sort.
+            auto const kth = proximities.begin() + nbNeighbours;
+            std::nth_element(proximities.begin(), kth - 1, proximities.end());
 
-    for (int i = 1; i <= nbClients; i++)
-        for (int x : set[i])
-            neighbours[i].push_back(x);
+            auto *first = neighbours.data() + (i - 1) * nbNeighbours;
+            for (size_t k = 0; k != nbNeighbours; ++k)
+                first[k] = proximities[k].second;
+
+            std::sort(first, first + nbNeighbours);
+        }
+    });
 }
@@ -2,28 +2,74 @@
 
 #include "Individual.h"
 #include "Params.h"
+#include "TaskScheduler.h"
 
+#include <algorithm>
 #include <memory>
+#include <numeric>
 #include <vector>
 
-void Population::generatePopulation(size_t numToGenerate)
+namespace
+{
+// Minimum number of client comparisons (population size times number of
+// clients) per chunk of the distance computations in addIndividual(). A
+// comparison takes about a nanosecond, so a chunk takes at least tens of
+// microseconds: much more than the cost of handing it to another thread.
+size_t const MIN_CHUNK_WORK = 1 << 16;
+}  // namespace
+
+void Population::generatePopulation(size_t numToGenerate,
+                                    CostEvaluator const &costEvaluator)
 {
     for (size_t count = 0; count != numToGenerate; ++count)  // generate random
     {                                                        // individuals
         Individual randomIndiv(&params, &rng);
-        addIndividual(randomIndiv);
+        addIndividual(randomIndiv, costEvaluator);
     }
 }
 
-void Population::addIndividual(Individual const &indiv)
+void Population::addIndividual(Individual const &indiv,
+                               CostEvaluator const &costEvaluator)
 {
     auto &subPop = indiv.isFeasible() ? feasible : infeasible;
-    auto indivPtr = std::make_unique<Individual>(indiv);
+    auto indivPtr = acquire(indiv);
+    auto const slot = acquireSlot();
+
+    // Compute the distances to the other individuals. These are then stored
+    // in the distance matrix. With the default population sizes this is only
+    // tens of microseconds of work, which is done serially; larger populations
+    // are split into equally sized chunks that are computed in parallel.
+    dists.resize(subPop.size());
+    auto const work = subPop.size() * static_cast<size_t>(params.nbClients);
+
+    if (work < 2 * MIN_CHUNK_WORK)
+    {
+        for (size_t idx = 0; idx != subPop.size(); ++idx)
+            dists[idx] = indivPtr->brokenPairsDistance(subPop[idx].indiv.get());
+    }
+    else
+    {
+        auto const scheduler = TaskScheduler::shared();
+        auto const nbChunks
+            = std::min(scheduler->numThreads(), work / MIN_CHUNK_WORK);
+
+        scheduler->parallelFor(nbChunks, [&](size_t chunk) {
+            for (auto idx = chunk; idx < subPop.size(); idx += nbChunks)
+                dists[idx]
+                    = indivPtr->brokenPairsDistance(subPop[idx].indiv.get());
+        });
+    }
+
+    for (size_t idx = 0; idx != subPop.size(); ++idx)
+    {
+        distances(slot, subPop[idx].slot) = dists[idx];
+        distances(subPop[idx].slot, slot) = dists[idx];
+    }
 
-    for (auto const &other : subPop)  // update distance to other individuals
-        indivPtr->registerNearbyIndividual(other.indiv.get());
+    distances(slot, slot) = 0;
 
-    IndividualWrapper wrapper = {std::move(indivPtr), 0};
+    auto const cost = indiv.cost(costEvaluator);
+    IndividualWrapper wrapper = {std::move(indivPtr), 0, cost, slot};
 
     // Insert individual into the population, leaving the cost ordering intact
     auto const place = std::lower_bound(subPop.begin(), subPop.end(), wrapper);
@@ -44,18 +90,96 @@ void Population::addIndividual(Individual const &indiv)
         }
     }
 
-    if (indiv.isFeasible() && indiv < bestSol)
+    if (indiv.isFeasible() && cost < bestSol.cost(costEvaluator))
         bestSol = indiv;
 }
 
-void Population::updateBiasedFitness(SubPopulation &subPop) const
+std::unique_ptr<Individual> Population::acquire(Individual const &indiv)
+{
+    if (pool.empty())
+        return std::make_unique<Individual>(indiv);
+
+    auto indivPtr = std::move(pool.back());
+    pool.pop_back();
+
+    *indivPtr = indiv;
+    return indivPtr;
+}
+
+void Population::release(SubPopulation &subPop, SubPopulation::iterator pos)
+{
+    freeSlots.push_back(pos->slot);
+    pool.push_back(std::move(pos->indiv));
+    subPop.erase(pos);
+}
+
+size_t Population::acquireSlot()
+{
+    if (freeSlots.empty())  // double the number of slots, and copy over the
+    {                       // distances between the slots in use.
+        auto const numSlots = distances.numRows();
+        auto const newNumSlots = std::max<size_t>(2 * numSlots, 1);
+        Matrix<int> newDistances(newNumSlots);
+
+        for (size_t row = 0; row != numSlots; ++row)
+            for (size_t col = 0; col != numSlots; ++col)
+                newDistances(row, col) = distances(row, col);
+
+        distances = std::move(newDistances);
+
+        for (auto slot = newNumSlots; slot != numSlots; --slot)
+            freeSlots.push_back(slot - 1);
+    }
+
+    auto const slot = freeSlots.back();
+    freeSlots.pop_back();
+    return slot;
+}
+
+double Population::avgBrokenPairsDistanceClosest(SubPopulation const &subPop,
+                                                 size_t idx,
+                                                 std::vector<int> &buffer) const
+{
+    auto const slot = subPop[idx].slot;
+
+    buffer.clear();
+    for (size_t other = 0; other != subPop.size(); ++other)
+        if (other != idx)
+            buffer.push_back(distances(slot, subPop[other].slot));
+
+    if (buffer.empty())
+        return 0.;
+
+    // We only need the sum of the nbClose smallest distances, not a full sort.
+    auto const maxSize = std::min(params.config.nbClose, buffer.size());
+    auto const last = buffer.begin() + maxSize;
+    std::nth_element(buffer.begin(), last - 1, buffer.end());
+    auto const result = std::accumulate(buffer.begin(), last, 0);
+
+    // Normalise broken pairs distance by # of clients and close neighbours
+    auto const numClose = static_cast<double>(maxSize);
+    return result / (params.nbClients * numClose);
+}
+
+bool Population::hasClone(SubPopulation const &subPop, size_t idx) const
+{
+    auto const slot = subPop[idx].slot;
+
+    for (size_t other = 0; other != subPop.size(); ++other)
+        if (other != idx && distances(slot, subPop[other].slot) == 0)
+            return true;
+
+    return false;
+}
+
+void Population::updateBiasedFitness(SubPopulation &subPop)
 {
     // Ranking the individuals based on their diversity contribution (decreasing
     // order of broken pairs distance)
-    std::vector<std::pair<double, size_t>> diversity;
+    diversity.clear();
     for (size_t idx = 0; idx != subPop.size(); idx++)
     {
-        auto const dist = subPop[idx].indiv->avgBrokenPairsDistanceClosest();
+        auto const dist = avgBrokenPairsDistanceClosest(subPop, idx, closest);
         diversity.emplace_back(dist, idx);
     }
 
@@ -76,10 +200,10 @@ void Population::updateBiasedFitness(SubPopulation &subPop) const
 
 bool Population::removeDuplicate(SubPopulation &subPop)
 {
-    for (auto it = subPop.begin(); it != subPop.end(); ++it)
-        if (it->indiv->hasClone())
+    for (size_t idx = 0; idx != subPop.size(); ++idx)
+        if (hasClone(subPop, idx))
         {
-            subPop.erase(it);
+            release(subPop, subPop.begin() + idx);
             return true;
         }
 
@@ -88,60 +212,91 @@ bool Population::removeDuplicate(SubPopulation &subPop)
 
 void Population::removeWorstBiasedFitness(SubPopulation &subPop)
 {
-    auto const &worstFitness = std::max_element(
+    auto const worstFitness = std::max_element(
         subPop.begin(), subPop.end(), [](auto const &a, auto const &b) {
             return a.fitness < b.fitness;
         });
 
-    auto const worstIdx = std::distance(subPop.begin(), worstFitness);
-    subPop.erase(subPop.begin() + worstIdx);
+    release(subPop, worstFitness);
 }
 
-void Population::restart()
+void Population::restart(CostEvaluator const &costEvaluator)
 {
-    feasible.resize(std::min(params.config.nbKeepOnRestart, feasible.size()));
-    infeasible.clear();
+    auto const nbKeep
+        = std::min(params.config.nbKeepOnRestart, feasible.size());
+
+    while (feasible.size() > nbKeep)
+        release(feasible, feasible.end() - 1);
 
-    generatePopulation(params.config.minPopSize);
+    while (!infeasible.empty())
+        release(infeasible, infeasible.end() - 1);
+
+    generatePopulation(params.config.minPopSize, costEvaluator);
 }
 
-Individual const *Population::getBinaryTournament()
+std::pair<Population::IndividualWrapper const *,
+          Population::SubPopulation const *>
+Population::getBinaryTournament()
 {
     auto const fSize = feasible.size();
     auto const popSize = fSize + infeasible.size();
 
     auto const idx1 = rng.randint(popSize);
-    auto &wrap1 = idx1 < fSize ? feasible[idx1] : infeasible[idx1 - fSize];
+    auto const *pop1 = idx1 < fSize ? &feasible : &infeasible;
+    auto const *wrap1 = &(*pop1)[idx1 < fSize ? idx1 : idx1 - fSize];
 
     auto const idx2 = rng.randint(popSize);
-    auto &wrap2 = idx2 < fSize ? feasible[idx2] : infeasible[idx2 - fSize];
+    auto const *pop2 = idx2 < fSize ? &feasible : &infeasible;
+    auto const *wrap2 = &(*pop2)[idx2 < fSize ? idx2 : idx2 - fSize];
+
+    if (wrap1->fitness < wrap2->fitness)
+        return std::make_pair(wrap1, pop1);
 
-    return (wrap1.fitness < wrap2.fitness ? wrap1.indiv : wrap2.indiv).get();
+    return std::make_pair(wrap2, pop2);
 }
 
 std::pair<Individual const *, Individual const *> Population::selectParents()
 {
-    auto const *par1 = getBinaryTournament();
-    auto const *par2 = getBinaryTournament();
+    // Individuals in the same sub-population have their distance stored in
+    // the distance matrix; otherwise it needs to be computed.
+    auto const brokenPairsDistance = [&](auto const &lhs, auto const &rhs) {
+        auto const [wrap1, pop1] = lhs;
+        auto const [wrap2, pop2] = rhs;
+
+        if (pop1 == pop2)
+            return distances(wrap1->slot, wrap2->slot);
+
+        return wrap1->indiv->brokenPairsDistance(wrap2->indiv.get());
+    };
+
+    auto const par1 = getBinaryTournament();
+    auto par2 = getBinaryTournament();
 
     auto const lowerBound = params.config.lbDiversity * params.nbClients;
     auto const upperBound = params.config.ubDiversity * params.nbClients;
-    auto diversity = par1->brokenPairsDistance(par2);
+    auto diversity = brokenPairsDistance(par1, par2);
 
     size_t tries = 1;
     while ((diversity < lowerBound || diversity > upperBound) && tries++ < 10)
     {
         par2 = getBinaryTournament();
-        diversity = par1->brokenPairsDistance(par2);
+        diversity = brokenPairsDistance(par1, par2);
     }
 
-    return std::make_pair(par1, par2);
+    return std::make_pair(par1.first->indiv.get(), par2.first->indiv.get());
 }
 
-Population::Population(Params &params, XorShift128 &rng)
+Population::Population(Params const &params,
+                       XorShift128 &rng,
+                       CostEvaluator const &costEvaluator)
     : params(params),
       rng(rng),
-      bestSol(&params, &rng)  // random initial best solution
+      bestSol(&params, &rng),  // random initial best solution
+      distances(2 * (params.config.minPopSize + params.config.generationSize
+                     + 1))
 {
-    generatePopulation(params.config.minPopSize);
+    for (auto slot = distances.numRows(); slot != 0; --slot)
+        freeSlots.push_back(slot - 1);
+
+    generatePopulation(params.config.minPopSize, costEvaluator);
 }
@@ -1,76 +1,254 @@
 #include "Route.h"
 
+#include <algorithm>
+#include <bit>
 #include <cmath>
 #include <ostream>
 
+using TWS = TimeWindowSegment;
+
+namespace
+{
+// Moves the last suffix elements of vec, which has size oldSize, such that
+// they become the last elements of vec once it is resized to newSize.
+template <typename T>
+void moveSuffix(std::vector<T> &vec,
+                size_t oldSize,
+                size_t newSize,
+                size_t suffix)
+{
+    if (newSize > oldSize)
+    {
+        vec.resize(newSize);
+        auto const from = vec.begin() + (oldSize - suffix);
+        std::copy_backward(from, from + suffix, vec.begin() + newSize);
+    }
+    else
+    {
+        auto const from = vec.begin() + (oldSize - suffix);
+        std::copy(from, from + suffix, vec.begin() + (newSize - suffix));
+        vec.resize(newSize);
+    }
+}
+}  // namespace
+
 void Route::update()
 {
-    auto const oldNodes = nodes;
-    setupNodes();
+    if (nodes.empty())  // first load: the start depot never changes, so its
+    {                   // cumulative data is only set here.
+        nodes.push_back(depot);
+        loads.push_back(0);
+        distances.push_back(0);
+        reversalDistances.push_back(0);
+        twsBefore.push_back(depot->tw);
+        twsAfter.push_back(depot->tw);
+        sectors.emplace_back();
 
-    int load = 0;
-    int distance = 0;
-    int reverseDistance = 0;
-    bool foundChange = false;
+        depot->position = 0;
+    }
+
+    auto const oldSize = nodes.size();
+
+    // The nodes at positions [1, first) are the same as before, so their
+    // positions and cumulative data are still valid.
+    size_t first = 1;
+    auto *firstChanged = n(depot);
 
-    for (size_t pos = 0; pos != nodes.size(); ++pos)
+    while (first != oldSize && nodes[first] == firstChanged
+           && !firstChanged->isDepot())
     {
-        auto *node = nodes[pos];
+        firstChanged = n(firstChanged);
+        ++first;
+    }
 
-        if (!foundChange && (pos >= oldNodes.size() || node != oldNodes[pos]))
-        {
-            foundChange = true;
+    // The last suffix nodes (ending with the end depot) are also the same as
+    // before. Their positions shift, but their twsAfter data is still valid.
+    size_t suffix = 0;
 
-            if (pos > 0)  // change at pos, so everything before is the same
-            {             // and we can re-use cumulative calculations
-                load = nodes[pos - 1]->cumulatedLoad;
-                distance = nodes[pos - 1]->cumulatedDistance;
-                reverseDistance = nodes[pos - 1]->cumulatedReversalDistance;
-            }
+    if (oldSize > 1)  // then the route already has its end depot
+    {
+        auto *node = nodes.back();
+
+        while (oldSize - suffix > first && nodes[oldSize - suffix - 1] == node)
+        {
+            node = p(node);
+            ++suffix;
         }
+    }
+
+    // Number of nodes between the unchanged prefix and suffix.
+    auto *const suffixHead = suffix != 0 ? nodes[oldSize - suffix] : nullptr;
+    size_t nbChanged = 0;
 
-        if (!foundChange)
-            continue;
+    for (auto *node = firstChanged; node != suffixHead; node = n(node))
+    {
+        ++nbChanged;
+
+        if (node->isDepot())  // without an unchanged suffix, the end depot is
+            break;            // one of the changed nodes
+    }
 
-        load += params->clients[node->client].demand;
-        distance += params->dist(p(node)->client, node->client);
+    auto const newSize = first + nbChanged + suffix;
 
-        reverseDistance += params->dist(node->client, p(node)->client);
-        reverseDistance -= params->dist(p(node)->client, node->client);
+    if (nbChanged == 0 && newSize == oldSize)  // nothing has changed
+        return;
+
+    for (auto pos = first; pos != oldSize - suffix; ++pos)
+        if (!nodes[pos]->isDepot())
+        {
+            sumX -= params->x(nodes[pos]->client);
+            sumY -= params->y(nodes[pos]->client);
+        }
 
-        node->position = pos + 1;
-        node->cumulatedLoad = load;
-        node->cumulatedDistance = distance;
-        node->cumulatedReversalDistance = reverseDistance;
-        node->twBefore = TimeWindowSegment::merge(p(node)->twBefore, node->tw);
+    moveSuffix(nodes, oldSize, newSize, suffix);
+    moveSuffix(twsAfter, oldSize, newSize, suffix);
+
+    auto *node = firstChanged;
+    for (auto pos = first; pos != first + nbChanged; ++pos, node = n(node))
+    {
+        nodes[pos] = node;
+
+        if (!node->isDepot())
+        {
+            sumX += params->x(node->client);
+            sumY += params->y(node->client);
+        }
     }
 
+    loads.resize(newSize);
+    distances.resize(newSize);
+    reversalDistances.resize(newSize);
+    twsBefore.resize(newSize);
+    sectors.resize(newSize);
+
+    // The distance matrix's storage type is tested once, rather than on
+    // every lookup.
+    params->distanceMatrix().visit([&](auto const &distMat) {
+        // Everything from the first change onwards needs new positions and new
+        // cumulative data from the depot.
+        for (auto pos = first; pos != newSize; ++pos)
+        {
+            auto *node = nodes[pos];
+            auto const prev = nodes[pos - 1]->client;
+
+            node->position = pos;
+
+            loads[pos] = loads[pos - 1] + params->demand(node->client);
+            distances[pos] = distances[pos - 1] + distMat(prev, node->client);
+
+            reversalDistances[pos] = reversalDistances[pos - 1]
+                                     + distMat(node->client, prev)
+                                     - distMat(prev, node->client);
+
+            twsBefore[pos] = TWS::merge(distMat, twsBefore[pos - 1], node->tw);
+
+            sectors[pos] = sectors[pos - 1];
+            if (!node->isDepot())
+                sectors[pos].extend(params->angle(node->client));
+        }
+
+        // Everything up to the last change needs new time window data towards
+        // the end depot.
+        auto pos = newSize - suffix;
+
+        if (suffix == 0)
+        {
+            twsAfter[newSize - 1] = nodes[newSize - 1]->tw;
+            --pos;
+        }
+
+        while (pos-- != 0)
+            twsAfter[pos]
+                = TWS::merge(distMat, nodes[pos]->tw, twsAfter[pos + 1]);
+    });
+
+    // The time window blocks are only needed by twBetween() queries, which
+    // many updated routes do not get before their next update. So here they
+    // are only marked as out of date.
+    staleBlocksFrom = std::min(staleBlocksFrom, first);
+
     setupAngle();
-    setupRouteTimeWindows();
 }
 
-void Route::setupNodes()
+void Route::rebuildBlocks() const
 {
-    nodes.clear();
-    auto *node = depot;
+    params->distanceMatrix().visit(
+        [&](auto const &distMat) { rebuildBlocks(distMat); });
 
-    do
-    {
-        node = n(node);
-        nodes.push_back(node);
-    } while (!node->isDepot());
+    staleBlocksFrom = BLOCKS_UP_TO_DATE;
 }
 
-void Route::setupRouteTimeWindows()
+template <typename DistMat>
+void Route::rebuildBlocks(DistMat const &distMat) const
 {
-    auto *node = nodes.back();
+    auto const first = staleBlocksFrom;
+    size_t const nbLevels = std::bit_width(nodes.size() - 1);
 
-    do  // forward time window data
+    if (twsBlocks.size() < nbLevels)
     {
-        auto *prev = p(node);
-        prev->twAfter = TimeWindowSegment::merge(prev->tw, node->twAfter);
-        node = prev;
-    } while (!node->isDepot());
+        twsBlocks.resize(nbLevels);
+        twsReversedBlocks.resize(nbLevels);
+    }
+
+    // Levels beyond the current number of levels are not maintained. They are
+    // cleared (which keeps their storage), so they are built in full should
+    // the route grow long enough to need them again.
+    for (auto level = nbLevels; level != twsBlocks.size(); ++level)
+    {
+        twsBlocks[level].clear();
+        twsReversedBlocks[level].clear();
+    }
+
+    for (size_t level = 1; level <= nbLevels; ++level)
+    {
+        auto &blocks = twsBlocks[level - 1];
+        auto &revBlocks = twsReversedBlocks[level - 1];
+        auto const levelFirst = blocks.empty() ? 0 : first;
+        blocks.resize(nodes.size());
+        revBlocks.resize(nodes.size());
+
+        auto const half = size_t(1) << (level - 1);
+        auto const blockStart = levelFirst & ~(2 * half - 1);
+
+        // Entries before the changed position are still valid, unless they
+        // are in the first half of the block containing it (those entries
+        // extend to the middle of the block, past the changed position).
+        for (auto mid = blockStart + half; mid - half < nodes.size();
+             mid += 2 * half)
+        {
+            if (levelFirst < mid)  // first half, from the middle backwards
+            {
+                auto pos = std::min(mid, nodes.size()) - 1;
+                blocks[pos] = nodes[pos]->tw;
+                revBlocks[pos] = nodes[pos]->tw;
+
+                for (; pos != mid - half; --pos)
+                {
+                    auto const &tw = nodes[pos - 1]->tw;
+                    blocks[pos - 1] = TWS::merge(distMat, tw, blocks[pos]);
+                    revBlocks[pos - 1]
+                        = TWS::merge(distMat, revBlocks[pos], tw);
+                }
+            }
+
+            auto const end = std::min(mid + half, nodes.size());
+            auto pos = std::max(levelFirst, mid);  // second half, onwards from
+                                                   // the middle
+            if (pos == mid && mid < end)
+            {
+                blocks[pos] = nodes[mid]->tw;
+                revBlocks[pos] = nodes[mid]->tw;
+                ++pos;
+            }
+
+            for (; pos < end; ++pos)
+            {
+                auto const &tw = nodes[pos]->tw;
+                blocks[pos] = TWS::merge(distMat, blocks[pos - 1], tw);
+                revBlocks[pos] = TWS::merge(distMat, tw, revBlocks[pos - 1]);
+            }
+        }
+    }
 }
 
 void Route::setupAngle()
@@ -81,24 +259,12 @@ void Route::setupAngle()
         return;
     }
 
-    int cumulatedX = 0;
-    int cumulatedY = 0;
-
-    for (auto it = nodes.begin(); it != nodes.end() - 1; ++it)
-    {
-        auto const *node = *it;
-        assert(!node->isDepot());
-
-        cumulatedX += params->clients[node->client].x;
-        cumulatedY += params->clients[node->client].y;
-    }
-
     // This computes a pseudo-angle that sorts roughly equivalently to the atan2
     // angle, but is much faster to compute. See the following post for details:
     // https://stackoverflow.com/a/16561333/4316405.
     auto const routeSize = static_cast<double>(size());
-    auto const dy = cumulatedY / routeSize - params->clients[0].y;
-    auto const dx = cumulatedX / routeSize - params->clients[0].x;
+    auto const dy = sumY / routeSize - params->y(0);
+    auto const dx = sumX / routeSize - params->x(0);
     angleCenter = std::copysign(1. - dx / (std::fabs(dx) + std::fabs(dy)), dy);
 }
 
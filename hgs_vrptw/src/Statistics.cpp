@@ -8,7 +8,8 @@ namespace
 {
 using std::accumulate;
 
-void collectSubPopStats(Population::SubPopulation const &subPop,
+void collectSubPopStats(Population const &pop,
+                        Population::SubPopulation const &subPop,
                         Statistics::SubPopStats &subStats)
 {
     if (subPop.empty())
@@ -24,30 +25,29 @@ void collectSubPopStats(Population::SubPopulation const &subPop,
     auto const popSize = subPop.size();
     subStats.popSize_.push_back(popSize);
 
-    auto const opDiv = [](double val, auto const &sub) {
-        return val + sub.indiv->avgBrokenPairsDistanceClosest();
-    };
-    auto const totalDiv = accumulate(subPop.begin(), subPop.end(), 0., opDiv);
+    double totalDiv = 0.;
+    for (size_t idx = 0; idx != popSize; ++idx)
+        totalDiv += pop.avgBrokenPairsDistanceClosest(subPop, idx);
+
     subStats.avgDiversity_.push_back(totalDiv / popSize);
 
-    subStats.bestCost_.push_back(subPop[0].indiv->cost());
+    subStats.bestCost_.push_back(subPop[0].cost);
 
     auto const opCost
-        = [](size_t sum, auto const &sub) { return sum + sub.indiv->cost(); };
+        = [](size_t sum, auto const &sub) { return sum + sub.cost; };
     auto const totalCost = accumulate(subPop.begin(), subPop.end(), 0, opCost);
     subStats.avgCost_.push_back(totalCost / popSize);
 
     double numRoutes = 0.0;
     for (auto &wrapper : subPop)
-        for (auto &route : wrapper.indiv->getRoutes())
-            if (!route.empty())
-                numRoutes += 1;
+        numRoutes += wrapper.indiv->numRoutes();
 
     subStats.avgNumRoutes_.push_back(numRoutes / popSize);
 }
 }  // namespace
 
-void Statistics::collectFrom(Population const &pop)
+void Statistics::collectFrom(Population const &pop,
+                             CostEvaluator const &costEvaluator)
 {
     numIters_++;
 
@@ -62,12 +62,12 @@ void Statistics::collectFrom(Population const &pop)
     lastIter = clock::now();  // update for next call
 
     // Population statistics
-    collectSubPopStats(pop.feasible, feasStats);
-    collectSubPopStats(pop.infeasible, infeasStats);
+    collectSubPopStats(pop, pop.feasible, feasStats);
+    collectSubPopStats(pop, pop.infeasible, infeasStats);
 
     // Penalty statistics
-    penaltiesCapacity_.push_back(pop.params.penaltyCapacity);
-    penaltiesTimeWarp_.push_back(pop.params.penaltyTimeWarp);
+    penaltiesCapacity_.push_back(costEvaluator.penaltyCapacity());
+    penaltiesTimeWarp_.push_back(costEvaluator.penaltyTimeWarp());
 
     // Incumbents
     auto const &best = pop.bestSol;
@@ -75,10 +75,10 @@ void Statistics::collectFrom(Population const &pop)
     if (!best.isFeasible())
         return;
 
-    if (incumbents_.empty() || best.cost() < incumbents_.back().second)
+    if (incumbents_.empty() || best.distance() < incumbents_.back().second)
     {
         std::chrono::duration<double> time = clock::now() - start;
-        incumbents_.emplace_back(time.count(), best.cost());
+        incumbents_.emplace_back(time.count(), best.distance());
     }
 }
 
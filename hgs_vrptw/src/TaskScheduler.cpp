@@ -0,0 +1,245 @@
+#include "TaskScheduler.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+// Scheduler and queue index of the current thread, if that is a worker.
+thread_local TaskScheduler const *currScheduler = nullptr;
+thread_local size_t currQueue = 0;
+
+// Group of the task the current thread is running, if any.
+thread_local TaskScheduler::TaskGroup const *currGroup = nullptr;
+
+std::mutex sharedMutex;  // protects sharedScheduler, and creating leases
+std::unique_ptr<TaskScheduler> sharedScheduler;
+std::atomic<size_t> nbLeases = 0;  // number of leases on sharedScheduler
+}  // namespace
+
+void TaskScheduler::push(Task task)
+{
+    auto const idx = currScheduler == this ? currQueue : queues.size() - 1;
+
+    {
+        std::lock_guard<std::mutex> guard(queues[idx]->mutex);
+        queues[idx]->tasks.push_back(std::move(task));
+        nbQueued++;
+        nbPushed++;
+    }
+
+    {  // locking ensures sleeping threads do not miss the notification
+        std::lock_guard<std::mutex> guard(sleepMutex);
+    }
+
+    // Waiting threads only run some of the tasks, so we wake all sleeping
+    // threads: notifying just one could wake a thread that cannot run the new
+    // task, while an idle worker that can keeps sleeping.
+    sleepCondition.notify_all();
+}
+
+bool TaskScheduler::tryRunTask(TaskGroup const *group)
+{
+    auto const own = currScheduler == this ? currQueue : queues.size() - 1;
+    Task task;
+
+    // Tasks of groups created within a task of the given group have that
+    // group among their ancestors. These ancestors are all alive, since each
+    // waits for the tasks below it.
+    auto const isEligible = [group](Task const &task) {
+        for (auto const *curr = task.group; curr; curr = curr->parent)
+            if (curr == group)
+                return true;
+
+        return group == nullptr;
+    };
+
+    auto const pop = [&](Queue &queue, bool newest) {
+        std::lock_guard<std::mutex> guard(queue.mutex);
+        auto &tasks = queue.tasks;
+
+        for (size_t idx = 0; idx != tasks.size(); ++idx)
+        {
+            auto const pos = newest ? tasks.size() - 1 - idx : idx;
+
+            if (isEligible(tasks[pos]))
+            {
+                task = std::move(tasks[pos]);
+                tasks.erase(tasks.begin() + pos);
+                return true;
+            }
+        }
+
+        return false;
+    };
+
+    // Workers first run the newest task in their own queue. Otherwise, we
+    // take the oldest task in any of the other queues (including the shared
+    // queue): that task is likely to spawn more work.
+    bool found = own != queues.size() - 1 && pop(*queues[own], true);
+
+    for (size_t step = 1; !found && step <= queues.size(); ++step)
+        found = pop(*queues[(own + step) % queues.size()], false);
+
+    if (!found)
+        return false;
+
+    nbQueued--;
+
+    auto const *const prevGroup = std::exchange(currGroup, task.group);
+    task.fn();
+    currGroup = prevGroup;
+
+    return true;
+}
+
+void TaskScheduler::work(size_t idx)
+{
+    currScheduler = this;
+    currQueue = idx;
+
+    while (true)
+    {
+        if (tryRunTask())
+            continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepCondition.wait(lock, [&]() { return stopping || nbQueued > 0; });
+
+        if (stopping && nbQueued == 0)
+            return;
+    }
+}
+
+TaskScheduler::TaskGroup::TaskGroup(TaskScheduler &scheduler)
+    : scheduler(scheduler), parent(currGroup)
+{
+}
+
+TaskScheduler::TaskGroup::~TaskGroup()
+{
+    try
+    {
+        wait();
+    }
+    catch (...)
+    {
+    }
+}
+
+void TaskScheduler::TaskGroup::run(std::function<void()> task)
+{
+    pending++;
+
+    auto const fn = [this, task = std::move(task)]() {
+        try
+        {
+            task();
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> guard(errorMutex);
+
+            if (!error)
+                error = std::current_exception();
+        }
+
+        // The group may be destroyed as soon as pending reaches zero, so we
+        // should not access its members after the decrement.
+        auto &sched = scheduler;
+
+        if (--pending == 0)
+        {
+            std::lock_guard<std::mutex> guard(sched.sleepMutex);
+            sched.sleepCondition.notify_all();
+        }
+    };
+
+    scheduler.push({fn, this});
+}
+
+void TaskScheduler::TaskGroup::wait()
+{
+    while (pending > 0)
+    {
+        auto const nbPushed = scheduler.nbPushed.load();
+
+        if (scheduler.tryRunTask(this))
+            continue;
+
+        // Any task queued since the attempt above may have been forked within
+        // one of our tasks, so then we try again.
+        std::unique_lock<std::mutex> lock(scheduler.sleepMutex);
+        scheduler.sleepCondition.wait(lock, [&]() {
+            return pending == 0 || scheduler.nbPushed != nbPushed;
+        });
+    }
+
+    std::lock_guard<std::mutex> guard(errorMutex);
+
+    if (error)
+        std::rethrow_exception(std::exchange(error, nullptr));
+}
+
+TaskScheduler::Lease::Lease(TaskScheduler &scheduler) : scheduler(scheduler)
+{
+    nbLeases++;
+}
+
+TaskScheduler::Lease::~Lease() { nbLeases--; }
+
+TaskScheduler::Lease TaskScheduler::shared()
+{
+    std::lock_guard<std::mutex> guard(sharedMutex);
+
+    if (!sharedScheduler)
+    {
+        // A single thread by default, since the solver is often run in one
+        // process per core already.
+        auto const *env = std::getenv("HGS_NUM_THREADS");
+        auto const nbThreads = env ? std::max(std::atoi(env), 1) : 1;
+        sharedScheduler = std::make_unique<TaskScheduler>(nbThreads);
+    }
+
+    return Lease(*sharedScheduler);
+}
+
+void TaskScheduler::setSharedThreads(size_t nbThreads)
+{
+    // New leases are only created while holding the mutex, so none can be
+    // taken between the check below and replacing the scheduler.
+    std::lock_guard<std::mutex> guard(sharedMutex);
+
+    if (nbLeases > 0)
+        throw std::runtime_error(
+            "The number of threads cannot be changed while the task scheduler "
+            "is in use.");
+
+    sharedScheduler = std::make_unique<TaskScheduler>(nbThreads);
+}
+
+TaskScheduler::TaskScheduler(size_t nbThreads)
+{
+    auto const nbWorkers = std::max<size_t>(nbThreads, 1) - 1;
+
+    for (size_t idx = 0; idx != nbWorkers + 1; ++idx)
+        queues.push_back(std::make_unique<Queue>());
+
+    for (size_t idx = 0; idx != nbWorkers; ++idx)
+        workers.emplace_back(&TaskScheduler::work, this, idx);
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    {
+        std::lock_guard<std::mutex> guard(sleepMutex);
+        stopping = true;
+    }
+
+    sleepCondition.notify_all();
+
+    for (auto &worker : workers)
+        worker.join();
+}
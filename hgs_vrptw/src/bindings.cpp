@@ -1,4 +1,5 @@
 #include "Config.h"
+#include "CostEvaluator.h"
 #include "Exchange.h"
 #include "GeneticAlgorithm.h"
 #include "Individual.h"
@@ -14,14 +15,18 @@
 #include "Statistics.h"
 #include "StoppingCriterion.h"
 #include "SwapStar.h"
+#include "TaskScheduler.h"
 #include "TwoOpt.h"
 #include "XorShift128.h"
 #include "crossover.h"
+#include "solveBatch.h"
 
 #include <pybind11/chrono.h>
 #include <pybind11/functional.h>
 #include <pybind11/stl.h>
 
+#include <limits>
+
 namespace py = pybind11;
 
 PYBIND11_MODULE(hgspy, m)
@@ -33,32 +38,61 @@ PYBIND11_MODULE(hgspy, m)
         .def(py::init<Params *, XorShift128 *>(),
              py::arg("params"),
              py::arg("rng"))
-        .def(py::init<Params *, std::vector<std::vector<int>>>(),
+        .def(py::init([](Params *params,
+                         std::vector<std::vector<int>> routes) {
+                 // Routes from Python use the clients' instance indices.
+                 for (auto &route : routes)
+                     for (auto &client : route)
+                         client = params->internalId(client);
+
+                 return Individual(params, std::move(routes));
+             }),
              py::arg("params"),
              py::arg("routes"))
-        .def("cost", &Individual::cost)
-        .def("get_routes", &Individual::getRoutes)
-        .def("get_neighbours", &Individual::getNeighbours)
+        .def("cost", &Individual::cost, py::arg("cost_evaluator"))
+        .def("distance", &Individual::distance)
+        .def("get_routes", &Individual::getOriginalRoutes)
+        .def("get_neighbours", &Individual::getOriginalNeighbours)
         .def("is_feasible", &Individual::isFeasible)
         .def("has_excess_capacity", &Individual::hasExcessCapacity)
         .def("has_time_warp", &Individual::hasTimeWarp)
         .def("broken_pairs_distance", &Individual::brokenPairsDistance)
-        .def("export_cvrplib_format", &Individual::exportCVRPLibFormat);
+        .def("export_cvrplib_format",
+             &Individual::exportCVRPLibFormat,
+             py::arg("path"),
+             py::arg("time"),
+             py::arg("cost_evaluator"));
 
+    // The long-running calls below release the GIL. The C++ objects only keep
+    // references to their arguments, so those are kept alive as long as the
+    // objects that refer to them. Objects that may not be used concurrently
+    // raise an error when that happens, rather than corrupting their state.
     py::class_<LocalSearch>(m, "LocalSearch")
-        .def(py::init<Params &, XorShift128 &>(),
+        .def(py::init<Params const &, XorShift128 &>(),
              py::arg("params"),
-             py::arg("rng"))
+             py::arg("rng"),
+             py::keep_alive<1, 2>(),
+             py::keep_alive<1, 3>())
         .def("add_node_operator",
              static_cast<void (LocalSearch::*)(LocalSearchOperator<Node> &)>(
                  &LocalSearch::addNodeOperator),
-             py::arg("op"))
+             py::arg("op"),
+             py::keep_alive<1, 2>())
         .def("add_route_operator",
              static_cast<void (LocalSearch::*)(LocalSearchOperator<Route> &)>(
                  &LocalSearch::addRouteOperator),
-             py::arg("op"))
-        .def("search", &LocalSearch::search, py::arg("indiv"))
-        .def("intensify", &LocalSearch::intensify, py::arg("indiv"));
+             py::arg("op"),
+             py::keep_alive<1, 2>())
+        .def("search",
+             &LocalSearch::search,
+             py::arg("indiv"),
+             py::arg("cost_evaluator"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("intensify",
+             &LocalSearch::intensify,
+             py::arg("indiv"),
+             py::arg("cost_evaluator"),
+             py::call_guard<py::gil_scoped_release>());
 
     py::class_<Config>(m, "Config")
         .def(py::init<int,
@@ -86,7 +120,14 @@ PYBIND11_MODULE(hgspy, m)
                       int,
                       int,
                       bool,
-                      size_t>(),
+                      size_t,
+                      size_t,
+                      size_t,
+                      size_t,
+                      size_t,
+                      bool,
+                      bool,
+                      bool>(),
              py::arg("seed") = 0,
              py::arg("nbIter") = 10'000,
              py::arg("timeLimit") = INT_MAX,
@@ -112,7 +153,14 @@ PYBIND11_MODULE(hgspy, m)
              py::arg("weightWaitTime") = 18,
              py::arg("weightTimeWarp") = 20,
              py::arg("shouldIntensify") = true,
-             py::arg("postProcessPathLength") = 7)
+             py::arg("postProcessPathLength") = 7,
+             py::arg("nbIslands") = 1,
+             py::arg("migrationInterval") = 50,
+             py::arg("batchSize") = 1,
+             py::arg("nbThreads") = 1,
+             py::arg("parallelIntensify") = false,
+             py::arg("renumberClients") = false,
+             py::arg("circleSectorFilter") = false)
         .def_readonly("seed", &Config::seed)
         .def_readonly("nbIter", &Config::nbIter)
         .def_readonly("timeLimit", &Config::timeLimit)
@@ -137,7 +185,14 @@ PYBIND11_MODULE(hgspy, m)
         .def_readonly("nbGranular", &Config::nbGranular)
         .def_readonly("weightWaitTime", &Config::weightWaitTime)
         .def_readonly("weightTimeWarp", &Config::weightTimeWarp)
-        .def_readonly("postProcessPathLength", &Config::postProcessPathLength);
+        .def_readonly("postProcessPathLength", &Config::postProcessPathLength)
+        .def_readonly("nbIslands", &Config::nbIslands)
+        .def_readonly("migrationInterval", &Config::migrationInterval)
+        .def_readonly("batchSize", &Config::batchSize)
+        .def_readonly("nbThreads", &Config::nbThreads)
+        .def_readonly("parallelIntensify", &Config::parallelIntensify)
+        .def_readonly("renumberClients", &Config::renumberClients)
+        .def_readonly("circleSectorFilter", &Config::circleSectorFilter);
 
     py::class_<Params>(m, "Params")
         .def(py::init<Config const &,
@@ -157,13 +212,28 @@ PYBIND11_MODULE(hgspy, m)
              py::arg("duration_matrix"),
              py::arg("release_times"));
 
+    py::class_<CostEvaluator>(m, "CostEvaluator")
+        .def(py::init<Params const &>(), py::arg("params"))
+        .def(py::init<int, int, int>(),
+             py::arg("penalty_capacity"),
+             py::arg("penalty_time_warp"),
+             py::arg("vehicle_capacity"))
+        .def("load_penalty", &CostEvaluator::loadPenalty, py::arg("load"))
+        .def("tw_penalty", &CostEvaluator::twPenalty, py::arg("time_warp"))
+        .def("penalty_capacity", &CostEvaluator::penaltyCapacity)
+        .def("penalty_time_warp", &CostEvaluator::penaltyTimeWarp);
+
     py::class_<Population>(m, "Population")
-        .def(py::init<Params &, XorShift128 &>(),
+        .def(py::init<Params const &, XorShift128 &, CostEvaluator const &>(),
              py::arg("params"),
-             py::arg("rng"))
+             py::arg("rng"),
+             py::arg("cost_evaluator"),
+             py::keep_alive<1, 2>(),
+             py::keep_alive<1, 3>())
         .def("add_individual",
              &Population::addIndividual,
-             py::arg("individual"));
+             py::arg("individual"),
+             py::arg("cost_evaluator"));
 
     py::class_<Statistics>(m, "Statistics")
         .def("num_iters", &Statistics::numIters)
@@ -191,26 +261,59 @@ PYBIND11_MODULE(hgspy, m)
         .def("get_best_found",
              &Result::getBestFound,
              py::return_value_policy::reference)
+        .def("get_cost_evaluator",
+             &Result::getCostEvaluator,
+             py::return_value_policy::reference)
         .def("get_statistics",
              &Result::getStatistics,
              py::return_value_policy::reference)
         .def("get_iterations",
              &Result::getIterations,
              py::return_value_policy::reference)
+        .def("get_island_iterations",
+             &Result::getIslandIterations,
+             py::return_value_policy::reference)
         .def("get_run_time",
              &Result::getRunTime,
              py::return_value_policy::reference);
 
     py::class_<GeneticAlgorithm>(m, "GeneticAlgorithm")
-        .def(py::init<Params &, XorShift128 &, Population &, LocalSearch &>(),
+        .def(py::init<Params const &,
+                      XorShift128 &,
+                      Population &,
+                      LocalSearch &>(),
              py::arg("params"),
              py::arg("rng"),
              py::arg("population"),
-             py::arg("local_search"))
+             py::arg("local_search"),
+             py::keep_alive<1, 2>(),
+             py::keep_alive<1, 3>(),
+             py::keep_alive<1, 4>(),
+             py::keep_alive<1, 5>())
         .def("add_crossover_operator",
              &GeneticAlgorithm::addCrossoverOperator,
              py::arg("op"))
-        .def("run", &GeneticAlgorithm::run, py::arg("stop"));
+        .def("run",
+             &GeneticAlgorithm::run,
+             py::arg("stop"),
+             py::call_guard<py::gil_scoped_release>());
+
+    m.def("solve_batch",
+          &solveBatch,
+          py::arg("instances"),
+          py::arg("node_ops"),
+          py::arg("route_ops"),
+          py::arg("crossover_ops"),
+          py::arg("stop"),
+          py::call_guard<py::gil_scoped_release>());
+
+    m.def("set_num_threads",
+          &TaskScheduler::setSharedThreads,
+          py::arg("num_threads"),
+          py::call_guard<py::gil_scoped_release>());
+
+    m.def("get_num_threads",
+          []() { return TaskScheduler::shared()->numThreads(); });
 
     // Stopping criteria (as a submodule)
     py::module stop = m.def_submodule("stop");
@@ -222,7 +325,10 @@ PYBIND11_MODULE(hgspy, m)
         .def("__call__", &MaxIterations::operator());
 
     py::class_<MaxRuntime, StoppingCriterion>(stop, "MaxRuntime")
-        .def(py::init<double>(), py::arg("max_runtime"))
+        .def(py::init<double, double>(),
+             py::arg("max_runtime"),
+             py::arg("max_total_runtime")
+             = std::numeric_limits<double>::infinity())
         .def("__call__", &MaxRuntime::operator());
 
     // Crossover operators (as a submodule)
@@ -16,26 +16,24 @@ struct InsertPos  // best insert position, used to plan unplanned clients
 // Evaluates the cost change of inserting client between prev and next.
 int deltaCost(Client client, Client prev, Client next, Params const &params)
 {
-    int prevClientRelease = std::max(params.clients[prev].releaseTime,
-                                     params.clients[client].releaseTime);
+    int prevClientRelease
+        = std::max(params.releaseTime(prev), params.releaseTime(client));
     int prevEarliestArrival = std::max(prevClientRelease + params.dist(0, prev),
-                                       params.clients[prev].twEarly);
-    int prevEarliestFinish = prevEarliestArrival + params.clients[prev].servDur;
+                                       params.twEarly(prev));
+    int prevEarliestFinish = prevEarliestArrival + params.servDur(prev);
     int distPrevClient = params.dist(prev, client);
-    int clientLate = params.clients[client].twLate;
+    int clientLate = params.twLate(client);
 
     if (prevEarliestFinish + distPrevClient >= clientLate)
         return INT_MAX;
 
-    int clientNextRelease = std::max(params.clients[client].releaseTime,
-                                     params.clients[next].releaseTime);
-    int clientEarliestArrival
-        = std::max(clientNextRelease + params.dist(0, client),
-                   params.clients[client].twEarly);
-    int clientEarliestFinish
-        = clientEarliestArrival + params.clients[client].servDur;
+    int clientNextRelease
+        = std::max(params.releaseTime(client), params.releaseTime(next));
+    int clientEarliestArrival = std::max(
+        clientNextRelease + params.dist(0, client), params.twEarly(client));
+    int clientEarliestFinish = clientEarliestArrival + params.servDur(client);
     int distClientNext = params.dist(client, next);
-    int nextLate = params.clients[next].twLate;
+    int nextLate = params.twLate(next);
 
     if (clientEarliestFinish + distClientNext >= nextLate)
         return INT_MAX;
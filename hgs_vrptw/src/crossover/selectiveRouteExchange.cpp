@@ -11,6 +11,7 @@ using Routes = std::vector<Route>;
 Individual selectiveRouteExchange(
     std::pair<Individual const *, Individual const *> const &parents,
     Params const &params,
+    CostEvaluator const &costEvaluator,
     XorShift128 &rng)
 {
     size_t nRoutesA = parents.first->numRoutes();
@@ -173,5 +174,8 @@ Individual selectiveRouteExchange(
     Individual indiv1{&params, routes1};
     Individual indiv2{&params, routes2};
 
-    return std::min(indiv1, indiv2);
+    auto const cost1 = indiv1.cost(costEvaluator);
+    auto const cost2 = indiv2.cost(costEvaluator);
+
+    return cost2 < cost1 ? indiv2 : indiv1;
 }
@@ -1,4 +1,5 @@
 #include "CommandLine.h"
+#include "CostEvaluator.h"
 #include "Exchange.h"
 #include "GeneticAlgorithm.h"
 #include "LocalSearch.h"
@@ -8,6 +9,7 @@
 #include "Population.h"
 #include "RelocateStar.h"
 #include "SwapStar.h"
+#include "TaskScheduler.h"
 #include "TwoOpt.h"
 #include "XorShift128.h"
 #include "crossover.h"
@@ -23,10 +25,12 @@ try
 
     CommandLine args(argc, argv);
     auto config = args.parse();
+    TaskScheduler::setSharedThreads(config.nbThreads);
 
     XorShift128 rng(config.seed);
     Params params(config, args.instPath());
-    Population pop(params, rng);
+    CostEvaluator costEvaluator(params);
+    Population pop(params, rng, costEvaluator);
 
     LocalSearch ls(params, rng);
 
@@ -65,7 +69,8 @@ try
 
     std::chrono::duration<double> const timeDelta = clock::now() - start;
     auto const &bestSol = res.getBestFound();
-    bestSol.exportCVRPLibFormat(args.solPath(), timeDelta.count());
+    bestSol.exportCVRPLibFormat(
+        args.solPath(), timeDelta.count(), res.getCostEvaluator());
 }
 catch (std::exception const &e)
 {
@@ -37,19 +37,23 @@ bool Exchange<N, M>::adjacent(Node *U, Node *V) const
 }
 
 template <size_t N, size_t M>
-int Exchange<N, M>::evalRelocateMove(Node *U, Node *V) const
+template <typename DistMat>
+int Exchange<N, M>::evalRelocateMove(DistMat const &distMat,
+                                     Node *U,
+                                     Node *V,
+                                     CostEvaluator const &costEvaluator) const
 {
     auto *endU = N == 1 ? U : (*U->route)[U->position + N - 1];
     auto const posU = U->position;
     auto const posV = V->position;
 
     int const current = U->route->distBetween(posU - 1, posU + N)
-                        + d_params.dist(V->client, n(V)->client);
+                        + distMat(V->client, n(V)->client);
 
-    int const proposed = d_params.dist(V->client, U->client)
+    int const proposed = distMat(V->client, U->client)
                          + U->route->distBetween(posU, posU + N - 1)
-                         + d_params.dist(endU->client, n(V)->client)
-                         + d_params.dist(p(U)->client, n(endU)->client);
+                         + distMat(endU->client, n(V)->client)
+                         + distMat(p(U)->client, n(endU)->client);
 
     int deltaCost = proposed - current;
 
@@ -58,28 +62,29 @@ int Exchange<N, M>::evalRelocateMove(Node *U, Node *V) const
         if (U->route->isFeasible() && deltaCost >= 0)
             return deltaCost;
 
-        auto uTWS = TWS::merge(p(U)->twBefore, n(endU)->twAfter);
+        auto uTWS = TWS::merge(distMat, p(U)->twBefore(), n(endU)->twAfter());
 
-        deltaCost += d_params.twPenalty(uTWS.totalTimeWarp());
-        deltaCost -= d_params.twPenalty(U->route->timeWarp());
+        deltaCost += costEvaluator.twPenalty(uTWS.totalTimeWarp());
+        deltaCost -= costEvaluator.twPenalty(U->route->timeWarp());
 
         auto const loadDiff = U->route->loadBetween(posU, posU + N - 1);
 
-        deltaCost += d_params.loadPenalty(U->route->load() - loadDiff);
-        deltaCost -= d_params.loadPenalty(U->route->load());
+        deltaCost += costEvaluator.loadPenalty(U->route->load() - loadDiff);
+        deltaCost -= costEvaluator.loadPenalty(U->route->load());
 
         if (deltaCost >= 0)    // if delta cost of just U's route is not enough
             return deltaCost;  // even without V, the move will never be good
 
-        deltaCost += d_params.loadPenalty(V->route->load() + loadDiff);
-        deltaCost -= d_params.loadPenalty(V->route->load());
+        deltaCost += costEvaluator.loadPenalty(V->route->load() + loadDiff);
+        deltaCost -= costEvaluator.loadPenalty(V->route->load());
 
-        auto vTWS = TWS::merge(V->twBefore,
+        auto vTWS = TWS::merge(distMat,
+                               V->twBefore(),
                                U->route->twBetween(posU, posU + N - 1),
-                               n(V)->twAfter);
+                               n(V)->twAfter());
 
-        deltaCost += d_params.twPenalty(vTWS.totalTimeWarp());
-        deltaCost -= d_params.twPenalty(V->route->timeWarp());
+        deltaCost += costEvaluator.twPenalty(vTWS.totalTimeWarp());
+        deltaCost -= costEvaluator.twPenalty(V->route->timeWarp());
     }
     else  // within same route
     {
@@ -90,31 +95,37 @@ int Exchange<N, M>::evalRelocateMove(Node *U, Node *V) const
 
         if (posU < posV)
         {
-            auto const tws = TWS::merge(p(U)->twBefore,
+            auto const tws = TWS::merge(distMat,
+                                        p(U)->twBefore(),
                                         route->twBetween(posU + N, posV),
                                         route->twBetween(posU, posU + N - 1),
-                                        n(V)->twAfter);
+                                        n(V)->twAfter());
 
-            deltaCost += d_params.twPenalty(tws.totalTimeWarp());
+            deltaCost += costEvaluator.twPenalty(tws.totalTimeWarp());
         }
         else
         {
-            auto const tws = TWS::merge(V->twBefore,
+            auto const tws = TWS::merge(distMat,
+                                        V->twBefore(),
                                         route->twBetween(posU, posU + N - 1),
                                         route->twBetween(posV + 1, posU - 1),
-                                        n(endU)->twAfter);
+                                        n(endU)->twAfter());
 
-            deltaCost += d_params.twPenalty(tws.totalTimeWarp());
+            deltaCost += costEvaluator.twPenalty(tws.totalTimeWarp());
         }
 
-        deltaCost -= d_params.twPenalty(route->timeWarp());
+        deltaCost -= costEvaluator.twPenalty(route->timeWarp());
     }
 
     return deltaCost;
 }
 
 template <size_t N, size_t M>
-int Exchange<N, M>::evalSwapMove(Node *U, Node *V) const
+template <typename DistMat>
+int Exchange<N, M>::evalSwapMove(DistMat const &distMat,
+                                 Node *U,
+                                 Node *V,
+                                 CostEvaluator const &costEvaluator) const
 {
     auto *endU = N == 1 ? U : (*U->route)[U->position + N - 1];
     auto *endV = M == 1 ? V : (*V->route)[V->position + M - 1];
@@ -128,12 +139,12 @@ int Exchange<N, M>::evalSwapMove(Node *U, Node *V) const
     int const proposed
         //   p(U) -> V -> ... -> endV -> n(endU)
         // + p(V) -> U -> ... -> endU -> n(endV)
-        = d_params.dist(p(U)->client, V->client)
+        = distMat(p(U)->client, V->client)
           + V->route->distBetween(posV, posV + M - 1)
-          + d_params.dist(endV->client, n(endU)->client)
-          + d_params.dist(p(V)->client, U->client)
+          + distMat(endV->client, n(endU)->client)
+          + distMat(p(V)->client, U->client)
           + U->route->distBetween(posU, posU + N - 1)
-          + d_params.dist(endU->client, n(endV)->client);
+          + distMat(endU->client, n(endV)->client);
 
     int deltaCost = proposed - current;
 
@@ -142,29 +153,31 @@ int Exchange<N, M>::evalSwapMove(Node *U, Node *V) const
         if (U->route->isFeasible() && V->route->isFeasible() && deltaCost >= 0)
             return deltaCost;
 
-        auto uTWS = TWS::merge(p(U)->twBefore,
+        auto uTWS = TWS::merge(distMat,
+                               p(U)->twBefore(),
                                V->route->twBetween(posV, posV + M - 1),
-                               n(endU)->twAfter);
+                               n(endU)->twAfter());
 
-        deltaCost += d_params.twPenalty(uTWS.totalTimeWarp());
-        deltaCost -= d_params.twPenalty(U->route->timeWarp());
+        deltaCost += costEvaluator.twPenalty(uTWS.totalTimeWarp());
+        deltaCost -= costEvaluator.twPenalty(U->route->timeWarp());
 
-        auto vTWS = TWS::merge(p(V)->twBefore,
+        auto vTWS = TWS::merge(distMat,
+                               p(V)->twBefore(),
                                U->route->twBetween(posU, posU + N - 1),
-                               n(endV)->twAfter);
+                               n(endV)->twAfter());
 
-        deltaCost += d_params.twPenalty(vTWS.totalTimeWarp());
-        deltaCost -= d_params.twPenalty(V->route->timeWarp());
+        deltaCost += costEvaluator.twPenalty(vTWS.totalTimeWarp());
+        deltaCost -= costEvaluator.twPenalty(V->route->timeWarp());
 
         auto const loadU = U->route->loadBetween(posU, posU + N - 1);
         auto const loadV = V->route->loadBetween(posV, posV + M - 1);
         auto const loadDiff = loadU - loadV;
 
-        deltaCost += d_params.loadPenalty(U->route->load() - loadDiff);
-        deltaCost -= d_params.loadPenalty(U->route->load());
+        deltaCost += costEvaluator.loadPenalty(U->route->load() - loadDiff);
+        deltaCost -= costEvaluator.loadPenalty(U->route->load());
 
-        deltaCost += d_params.loadPenalty(V->route->load() + loadDiff);
-        deltaCost -= d_params.loadPenalty(V->route->load());
+        deltaCost += costEvaluator.loadPenalty(V->route->load() + loadDiff);
+        deltaCost -= costEvaluator.loadPenalty(V->route->load());
     }
     else  // within same route
     {
@@ -175,32 +188,37 @@ int Exchange<N, M>::evalSwapMove(Node *U, Node *V) const
 
         if (posU < posV)
         {
-            auto const tws = TWS::merge(p(U)->twBefore,
+            auto const tws = TWS::merge(distMat,
+                                        p(U)->twBefore(),
                                         route->twBetween(posV, posV + M - 1),
                                         route->twBetween(posU + N, posV - 1),
                                         route->twBetween(posU, posU + N - 1),
-                                        n(endV)->twAfter);
+                                        n(endV)->twAfter());
 
-            deltaCost += d_params.twPenalty(tws.totalTimeWarp());
+            deltaCost += costEvaluator.twPenalty(tws.totalTimeWarp());
         }
         else
         {
-            auto const tws = TWS::merge(p(V)->twBefore,
+            auto const tws = TWS::merge(distMat,
+                                        p(V)->twBefore(),
                                         route->twBetween(posU, posU + N - 1),
                                         route->twBetween(posV + M, posU - 1),
                                         route->twBetween(posV, posV + M - 1),
-                                        n(endU)->twAfter);
+                                        n(endU)->twAfter());
 
-            deltaCost += d_params.twPenalty(tws.totalTimeWarp());
+            deltaCost += costEvaluator.twPenalty(tws.totalTimeWarp());
         }
 
-        deltaCost -= d_params.twPenalty(U->route->timeWarp());
+        deltaCost -= costEvaluator.twPenalty(U->route->timeWarp());
     }
 
     return deltaCost;
 }
 
-template <size_t N, size_t M> int Exchange<N, M>::evaluate(Node *U, Node *V)
+template <size_t N, size_t M>
+int Exchange<N, M>::evaluate(Node *U,
+                             Node *V,
+                             CostEvaluator const &costEvaluator)
 {
     if (containsDepot(U, N) || overlap(U, V))
         return 0;
@@ -214,7 +232,9 @@ template <size_t N, size_t M> int Exchange<N, M>::evaluate(Node *U, Node *V)
         if (U == n(V))
             return 0;
 
-        return evalRelocateMove(U, V);
+        return d_params.distanceMatrix().visit([&](auto const &distMat) {
+            return evalRelocateMove(distMat, U, V, costEvaluator);
+        });
     }
     else
     {
@@ -225,7 +245,9 @@ template <size_t N, size_t M> int Exchange<N, M>::evaluate(Node *U, Node *V)
         if (adjacent(U, V))
             return 0;
 
-        return evalSwapMove(U, V);
+        return d_params.distanceMatrix().visit([&](auto const &distMat) {
+            return evalSwapMove(distMat, U, V, costEvaluator);
+        });
     }
 }
 
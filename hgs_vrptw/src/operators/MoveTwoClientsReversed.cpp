@@ -5,19 +5,20 @@
 
 using TWS = TimeWindowSegment;
 
-int MoveTwoClientsReversed::evaluate(Node *U, Node *V)
+template <typename DistMat>
+int MoveTwoClientsReversed::evalMove(DistMat const &distMat,
+                                     Node *U,
+                                     Node *V,
+                                     CostEvaluator const &costEvaluator) const
 {
-    if (U == n(V) || n(U) == V || n(U)->isDepot())
-        return 0;
-
     auto const posU = U->position;
     auto const posV = V->position;
 
     int const current = U->route->distBetween(posU - 1, posU + 2)
-                        + d_params.dist(V->client, n(V)->client);
+                        + distMat(V->client, n(V)->client);
     int const proposed
-        = d_params.dist(p(U)->client, nn(U)->client)
-          + d_params.dist(V->client, n(U)->client, U->client, n(V)->client);
+        = distMat(p(U)->client, nn(U)->client)
+          + pathDist(distMat, V->client, n(U)->client, U->client, n(V)->client);
 
     int deltaCost = proposed - current;
 
@@ -26,26 +27,27 @@ int MoveTwoClientsReversed::evaluate(Node *U, Node *V)
         if (U->route->isFeasible() && deltaCost >= 0)
             return deltaCost;
 
-        auto uTWS = TWS::merge(p(U)->twBefore, nn(U)->twAfter);
+        auto uTWS = TWS::merge(distMat, p(U)->twBefore(), nn(U)->twAfter());
 
-        deltaCost += d_params.twPenalty(uTWS.totalTimeWarp());
-        deltaCost -= d_params.twPenalty(U->route->timeWarp());
+        deltaCost += costEvaluator.twPenalty(uTWS.totalTimeWarp());
+        deltaCost -= costEvaluator.twPenalty(U->route->timeWarp());
 
         auto const loadDiff = U->route->loadBetween(posU, posU + 1);
 
-        deltaCost += d_params.loadPenalty(U->route->load() - loadDiff);
-        deltaCost -= d_params.loadPenalty(U->route->load());
+        deltaCost += costEvaluator.loadPenalty(U->route->load() - loadDiff);
+        deltaCost -= costEvaluator.loadPenalty(U->route->load());
 
         if (deltaCost >= 0)    // if delta cost of just U's route is not enough
             return deltaCost;  // even without V, the move will never be good
 
-        deltaCost += d_params.loadPenalty(V->route->load() + loadDiff);
-        deltaCost -= d_params.loadPenalty(V->route->load());
+        deltaCost += costEvaluator.loadPenalty(V->route->load() + loadDiff);
+        deltaCost -= costEvaluator.loadPenalty(V->route->load());
 
-        auto vTWS = TWS::merge(V->twBefore, n(U)->tw, U->tw, n(V)->twAfter);
+        auto vTWS = TWS::merge(
+            distMat, V->twBefore(), n(U)->tw, U->tw, n(V)->twAfter());
 
-        deltaCost += d_params.twPenalty(vTWS.totalTimeWarp());
-        deltaCost -= d_params.twPenalty(V->route->timeWarp());
+        deltaCost += costEvaluator.twPenalty(vTWS.totalTimeWarp());
+        deltaCost -= costEvaluator.twPenalty(V->route->timeWarp());
     }
     else  // within same route
     {
@@ -56,27 +58,41 @@ int MoveTwoClientsReversed::evaluate(Node *U, Node *V)
 
         if (posU < posV)
         {
-            auto const uTWS = TWS::merge(p(U)->twBefore,
+            auto const uTWS = TWS::merge(distMat,
+                                         p(U)->twBefore(),
                                          route->twBetween(posU + 2, posV),
                                          n(U)->tw,
                                          U->tw,
-                                         n(V)->twAfter);
+                                         n(V)->twAfter());
 
-            deltaCost += d_params.twPenalty(uTWS.totalTimeWarp());
+            deltaCost += costEvaluator.twPenalty(uTWS.totalTimeWarp());
         }
         else
         {
-            auto const uTWS = TWS::merge(V->twBefore,
+            auto const uTWS = TWS::merge(distMat,
+                                         V->twBefore(),
                                          n(U)->tw,
                                          U->tw,
                                          route->twBetween(posV + 1, posU - 1),
-                                         nn(U)->twAfter);
+                                         nn(U)->twAfter());
 
-            deltaCost += d_params.twPenalty(uTWS.totalTimeWarp());
+            deltaCost += costEvaluator.twPenalty(uTWS.totalTimeWarp());
         }
 
-        deltaCost -= d_params.twPenalty(route->timeWarp());
+        deltaCost -= costEvaluator.twPenalty(route->timeWarp());
     }
 
     return deltaCost;
 }
+
+int MoveTwoClientsReversed::evaluate(Node *U,
+                                     Node *V,
+                                     CostEvaluator const &costEvaluator)
+{
+    if (U == n(V) || n(U) == V || n(U)->isDepot())
+        return 0;
+
+    return d_params.distanceMatrix().visit([&](auto const &distMat) {
+        return evalMove(distMat, U, V, costEvaluator);
+    });
+}
@@ -1,24 +1,29 @@
 #include "RelocateStar.h"
 
-int RelocateStar::evaluate(Route *U, Route *V)
+int RelocateStar::evaluate(Route *U,
+                           Route *V,
+                           CostEvaluator const &costEvaluator)
 {
     move = {};
 
     for (auto *nodeU = n(U->depot); !nodeU->isDepot(); nodeU = n(nodeU))
     {
-        int deltaCost = relocate.evaluate(nodeU, V->depot);  // test after depot
+        // Test inserting U after V's depot
+        int deltaCost = relocate.evaluate(nodeU, V->depot, costEvaluator);
 
         if (deltaCost < move.deltaCost)
             move = {deltaCost, nodeU, V->depot};
 
         for (auto *nodeV = n(V->depot); !nodeV->isDepot(); nodeV = n(nodeV))
         {
-            deltaCost = relocate.evaluate(nodeU, nodeV);  // test U after V
+            // Test inserting U after V
+            deltaCost = relocate.evaluate(nodeU, nodeV, costEvaluator);
 
             if (deltaCost < move.deltaCost)
                 move = {deltaCost, nodeU, nodeV};
 
-            deltaCost = relocate.evaluate(nodeV, nodeU);  // test V after U
+            // Test inserting V after U
+            deltaCost = relocate.evaluate(nodeV, nodeU, costEvaluator);
 
             if (deltaCost < move.deltaCost)
                 move = {deltaCost, nodeV, nodeU};
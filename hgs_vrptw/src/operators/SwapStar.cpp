@@ -2,66 +2,80 @@
 
 using TWS = TimeWindowSegment;
 
-void SwapStar::updateRemovalCosts(Route *R1)
+template <typename DistMat>
+void SwapStar::updateRemovalCosts(DistMat const &distMat,
+                                  Route *R1,
+                                  CostEvaluator const &costEvaluator)
 {
-    auto const currTimeWarp = d_params.twPenalty(R1->timeWarp());
+    auto const currTimeWarp = costEvaluator.twPenalty(R1->timeWarp());
 
     for (Node *U = n(R1->depot); !U->isDepot(); U = n(U))
     {
-        auto twData = TWS::merge(p(U)->twBefore, n(U)->twAfter);
-        removalCosts(R1->idx, U->client)
-            = d_params.dist(p(U)->client, n(U)->client)
-              - d_params.dist(p(U)->client, U->client, n(U)->client)
-              + d_params.twPenalty(twData.totalTimeWarp()) - currTimeWarp;
+        auto twData = TWS::merge(distMat, p(U)->twBefore(), n(U)->twAfter());
+        caches->removalCosts(R1->idx, U->client)
+            = distMat(p(U)->client, n(U)->client)
+              - pathDist(distMat, p(U)->client, U->client, n(U)->client)
+              + costEvaluator.twPenalty(twData.totalTimeWarp()) - currTimeWarp;
     }
 }
 
-void SwapStar::updateInsertionCost(Route *R, Node *U)
+template <typename DistMat>
+void SwapStar::updateInsertionCost(DistMat const &distMat,
+                                   Route *R,
+                                   Node *U,
+                                   CostEvaluator const &costEvaluator)
 {
-    auto &insertPositions = cache(R->idx, U->client);
+    auto &insertPositions = caches->insertPositions(R->idx, U->client);
 
     insertPositions = {};
     insertPositions.shouldUpdate = false;
 
     // Insert cost of U just after the depot (0 -> U -> ...)
-    auto twData = TWS::merge(R->depot->twBefore, U->tw, n(R->depot)->twAfter);
-    int cost = d_params.dist(0, U->client, n(R->depot)->client)
-               - d_params.dist(0, n(R->depot)->client)
-               + d_params.twPenalty(twData.totalTimeWarp())
-               - d_params.twPenalty(R->timeWarp());
+    auto twData = TWS::merge(
+        distMat, R->depot->twBefore(), U->tw, n(R->depot)->twAfter());
+    int cost = pathDist(distMat, 0, U->client, n(R->depot)->client)
+               - distMat(0, n(R->depot)->client)
+               + costEvaluator.twPenalty(twData.totalTimeWarp())
+               - costEvaluator.twPenalty(R->timeWarp());
 
     insertPositions.maybeAdd(cost, R->depot);
 
     for (Node *V = n(R->depot); !V->isDepot(); V = n(V))
     {
         // Insert cost of U just after V (V -> U -> ...)
-        twData = TWS::merge(V->twBefore, U->tw, n(V)->twAfter);
-        int deltaCost = d_params.dist(V->client, U->client, n(V)->client)
-                        - d_params.dist(V->client, n(V)->client)
-                        + d_params.twPenalty(twData.totalTimeWarp())
-                        - d_params.twPenalty(R->timeWarp());
+        twData = TWS::merge(distMat, V->twBefore(), U->tw, n(V)->twAfter());
+        int deltaCost = pathDist(distMat, V->client, U->client, n(V)->client)
+                        - distMat(V->client, n(V)->client)
+                        + costEvaluator.twPenalty(twData.totalTimeWarp())
+                        - costEvaluator.twPenalty(R->timeWarp());
 
         insertPositions.maybeAdd(deltaCost, V);
     }
 }
 
-std::pair<int, Node *> SwapStar::getBestInsertPoint(Node *U, Node *V)
+template <typename DistMat>
+std::pair<int, Node *>
+SwapStar::getBestInsertPoint(DistMat const &distMat,
+                             Node *U,
+                             Node *V,
+                             CostEvaluator const &costEvaluator)
 {
-    auto &best_ = cache(V->route->idx, U->client);
+    auto &best_ = caches->insertPositions(V->route->idx, U->client);
 
     if (best_.shouldUpdate)  // then we first update the insert positions
-        updateInsertionCost(V->route, U);
+        updateInsertionCost(distMat, V->route, U, costEvaluator);
 
     for (size_t idx = 0; idx != 3; ++idx)  // only OK if V is not adjacent
         if (best_.locs[idx] && best_.locs[idx] != V && n(best_.locs[idx]) != V)
             return std::make_pair(best_.costs[idx], best_.locs[idx]);
 
     // As a fallback option, we consider inserting in the place of V
-    auto const twData = TWS::merge(p(V)->twBefore, U->tw, n(V)->twAfter);
-    int deltaCost = d_params.dist(p(V)->client, U->client, n(V)->client)
-                    - d_params.dist(p(V)->client, n(V)->client)
-                    + d_params.twPenalty(twData.totalTimeWarp())
-                    - d_params.twPenalty(V->route->timeWarp());
+    auto const twData
+        = TWS::merge(distMat, p(V)->twBefore(), U->tw, n(V)->twAfter());
+    int deltaCost = pathDist(distMat, p(V)->client, U->client, n(V)->client)
+                    - distMat(p(V)->client, n(V)->client)
+                    + costEvaluator.twPenalty(twData.totalTimeWarp())
+                    - costEvaluator.twPenalty(V->route->timeWarp());
 
     return std::make_pair(deltaCost, p(V));
 }
@@ -69,59 +83,60 @@ std::pair<int, Node *> SwapStar::getBestInsertPoint(Node *U, Node *V)
 void SwapStar::init(Individual const &indiv)
 {
     LocalSearchOperator<Route>::init(indiv);
-    std::fill(updated.begin(), updated.end(), true);
+    std::fill(caches->updated.begin(), caches->updated.end(), true);
 }
 
-int SwapStar::evaluate(Route *routeU, Route *routeV)
+void SwapStar::prepare(Route *U, CostEvaluator const &costEvaluator)
 {
-    best = {};
+    if (!caches->updated[U->idx])
+        return;
 
-    if (updated[routeV->idx])
-    {
-        updateRemovalCosts(routeV);
-        updated[routeV->idx] = false;
+    d_params.distanceMatrix().visit([&](auto const &distMat) {
+        updateRemovalCosts(distMat, U, costEvaluator);
+    });
 
-        for (int idx = 1; idx != d_params.nbClients + 1; ++idx)
-            cache(routeV->idx, idx).shouldUpdate = true;
-    }
-
-    if (updated[routeU->idx])
-    {
-        updateRemovalCosts(routeU);
-        updated[routeV->idx] = false;
+    caches->updated[U->idx] = false;
 
-        for (int idx = 1; idx != d_params.nbClients + 1; ++idx)
-            cache(routeU->idx, idx).shouldUpdate = true;
-    }
+    for (int idx = 1; idx != d_params.nbClients + 1; ++idx)
+        caches->insertPositions(U->idx, idx).shouldUpdate = true;
+}
 
+template <typename DistMat>
+int SwapStar::evalMove(DistMat const &distMat,
+                       Route *routeU,
+                       Route *routeV,
+                       CostEvaluator const &costEvaluator)
+{
     for (Node *U = n(routeU->depot); !U->isDepot(); U = n(U))
         for (Node *V = n(routeV->depot); !V->isDepot(); V = n(V))
         {
             int deltaCost = 0;
 
-            int const uDemand = d_params.clients[U->client].demand;
-            int const vDemand = d_params.clients[V->client].demand;
+            int const uDemand = d_params.demand(U->client);
+            int const vDemand = d_params.demand(V->client);
             int const loadDiff = uDemand - vDemand;
 
-            deltaCost += d_params.loadPenalty(routeU->load() - loadDiff);
-            deltaCost -= d_params.loadPenalty(routeU->load());
+            deltaCost += costEvaluator.loadPenalty(routeU->load() - loadDiff);
+            deltaCost -= costEvaluator.loadPenalty(routeU->load());
 
-            deltaCost += d_params.loadPenalty(routeV->load() + loadDiff);
-            deltaCost -= d_params.loadPenalty(routeV->load());
+            deltaCost += costEvaluator.loadPenalty(routeV->load() + loadDiff);
+            deltaCost -= costEvaluator.loadPenalty(routeV->load());
 
-            deltaCost += removalCosts(routeU->idx, U->client);
-            deltaCost += removalCosts(routeV->idx, V->client);
+            deltaCost += caches->removalCosts(routeU->idx, U->client);
+            deltaCost += caches->removalCosts(routeV->idx, V->client);
 
             if (deltaCost >= 0)  // an early filter on many moves, before doing
                 continue;        // costly work determining insertion points
 
-            auto [extraV, UAfter] = getBestInsertPoint(U, V);
+            auto [extraV, UAfter]
+                = getBestInsertPoint(distMat, U, V, costEvaluator);
             deltaCost += extraV;
 
             if (deltaCost >= 0)  // continuing here avoids evaluating another
                 continue;        // costly insertion point below
 
-            auto [extraU, VAfter] = getBestInsertPoint(V, U);
+            auto [extraU, VAfter]
+                = getBestInsertPoint(distMat, V, U, costEvaluator);
             deltaCost += extraU;
 
             if (deltaCost < best.cost)
@@ -144,39 +159,44 @@ int SwapStar::evaluate(Route *routeU, Route *routeV)
 
     // Now do a full evaluation of the proposed swap move. This includes
     // possible time warp penalties.
-    int const current
-        = d_params.dist(p(best.U)->client, best.U->client, n(best.U)->client)
-          + d_params.dist(p(best.V)->client, best.V->client, n(best.V)->client);
-
-    int const proposed = d_params.dist(best.VAfter->client, best.V->client)
-                         + d_params.dist(best.UAfter->client, best.U->client);
+    int const current = pathDist(distMat,
+                                 p(best.U)->client,
+                                 best.U->client,
+                                 n(best.U)->client)
+                        + pathDist(distMat,
+                                   p(best.V)->client,
+                                   best.V->client,
+                                   n(best.V)->client);
+
+    int const proposed = distMat(best.VAfter->client, best.V->client)
+                         + distMat(best.UAfter->client, best.U->client);
 
     int deltaCost = proposed - current;
 
     if (best.VAfter == p(best.U))
     {
         // Insert in place of U
-        deltaCost += d_params.dist(best.V->client, n(best.U)->client);
+        deltaCost += distMat(best.V->client, n(best.U)->client);
     }
     else
     {
         deltaCost
-            += d_params.dist(best.V->client, n(best.VAfter)->client)
-               + d_params.dist(p(best.U)->client, n(best.U)->client)
-               - d_params.dist(best.VAfter->client, n(best.VAfter)->client);
+            += distMat(best.V->client, n(best.VAfter)->client)
+               + distMat(p(best.U)->client, n(best.U)->client)
+               - distMat(best.VAfter->client, n(best.VAfter)->client);
     }
 
     if (best.UAfter == p(best.V))
     {
         // Insert in place of V
-        deltaCost += d_params.dist(best.U->client, n(best.V)->client);
+        deltaCost += distMat(best.U->client, n(best.V)->client);
     }
     else
     {
         deltaCost
-            += d_params.dist(best.U->client, n(best.UAfter)->client)
-               + d_params.dist(p(best.V)->client, n(best.V)->client)
-               - d_params.dist(best.UAfter->client, n(best.UAfter)->client);
+            += distMat(best.U->client, n(best.UAfter)->client)
+               + distMat(p(best.V)->client, n(best.V)->client)
+               - distMat(best.UAfter->client, n(best.UAfter)->client);
     }
 
     // It is not possible to have UAfter == V or VAfter == U, so the positions
@@ -184,76 +204,94 @@ int SwapStar::evaluate(Route *routeU, Route *routeV)
     if (best.VAfter->position + 1 == best.U->position)
     {
         // Special case
-        auto uTWS
-            = TWS::merge(best.VAfter->twBefore, best.V->tw, n(best.U)->twAfter);
+        auto uTWS = TWS::merge(
+            distMat, best.VAfter->twBefore(), best.V->tw, n(best.U)->twAfter());
 
-        deltaCost += d_params.twPenalty(uTWS.totalTimeWarp());
+        deltaCost += costEvaluator.twPenalty(uTWS.totalTimeWarp());
     }
     else if (best.VAfter->position < best.U->position)
     {
         auto uTWS = TWS::merge(
-            best.VAfter->twBefore,
+            distMat,
+            best.VAfter->twBefore(),
             best.V->tw,
             routeU->twBetween(best.VAfter->position + 1, best.U->position - 1),
-            n(best.U)->twAfter);
+            n(best.U)->twAfter());
 
-        deltaCost += d_params.twPenalty(uTWS.totalTimeWarp());
+        deltaCost += costEvaluator.twPenalty(uTWS.totalTimeWarp());
     }
     else
     {
         auto uTWS = TWS::merge(
-            p(best.U)->twBefore,
+            distMat,
+            p(best.U)->twBefore(),
             routeU->twBetween(best.U->position + 1, best.VAfter->position),
             best.V->tw,
-            n(best.VAfter)->twAfter);
+            n(best.VAfter)->twAfter());
 
-        deltaCost += d_params.twPenalty(uTWS.totalTimeWarp());
+        deltaCost += costEvaluator.twPenalty(uTWS.totalTimeWarp());
     }
 
     if (best.UAfter->position + 1 == best.V->position)
     {
         // Special case
-        auto vTWS
-            = TWS::merge(best.UAfter->twBefore, best.U->tw, n(best.V)->twAfter);
+        auto vTWS = TWS::merge(
+            distMat, best.UAfter->twBefore(), best.U->tw, n(best.V)->twAfter());
 
-        deltaCost += d_params.twPenalty(vTWS.totalTimeWarp());
+        deltaCost += costEvaluator.twPenalty(vTWS.totalTimeWarp());
     }
     else if (best.UAfter->position < best.V->position)
     {
         auto vTWS = TWS::merge(
-            best.UAfter->twBefore,
+            distMat,
+            best.UAfter->twBefore(),
             best.U->tw,
             routeV->twBetween(best.UAfter->position + 1, best.V->position - 1),
-            n(best.V)->twAfter);
+            n(best.V)->twAfter());
 
-        deltaCost += d_params.twPenalty(vTWS.totalTimeWarp());
+        deltaCost += costEvaluator.twPenalty(vTWS.totalTimeWarp());
     }
     else
     {
         auto vTWS = TWS::merge(
-            p(best.V)->twBefore,
+            distMat,
+            p(best.V)->twBefore(),
             routeV->twBetween(best.V->position + 1, best.UAfter->position),
             best.U->tw,
-            n(best.UAfter)->twAfter);
+            n(best.UAfter)->twAfter());
 
-        deltaCost += d_params.twPenalty(vTWS.totalTimeWarp());
+        deltaCost += costEvaluator.twPenalty(vTWS.totalTimeWarp());
     }
 
-    deltaCost -= d_params.twPenalty(routeU->timeWarp());
-    deltaCost -= d_params.twPenalty(routeV->timeWarp());
+    deltaCost -= costEvaluator.twPenalty(routeU->timeWarp());
+    deltaCost -= costEvaluator.twPenalty(routeV->timeWarp());
 
-    auto const uDemand = d_params.clients[best.U->client].demand;
-    auto const vDemand = d_params.clients[best.V->client].demand;
+    auto const uDemand = d_params.demand(best.U->client);
+    auto const vDemand = d_params.demand(best.V->client);
 
-    deltaCost += d_params.loadPenalty(routeU->load() - uDemand + vDemand);
-    deltaCost -= d_params.loadPenalty(routeU->load());
+    deltaCost += costEvaluator.loadPenalty(routeU->load() - uDemand + vDemand);
+    deltaCost -= costEvaluator.loadPenalty(routeU->load());
 
-    deltaCost += d_params.loadPenalty(routeV->load() + uDemand - vDemand);
-    deltaCost -= d_params.loadPenalty(routeV->load());
+    deltaCost += costEvaluator.loadPenalty(routeV->load() + uDemand - vDemand);
+    deltaCost -= costEvaluator.loadPenalty(routeV->load());
 
     return deltaCost;
 }
 
+int SwapStar::evaluate(Route *routeU,
+                       Route *routeV,
+                       CostEvaluator const &costEvaluator)
+{
+    best = {};
+
+    prepare(routeV, costEvaluator);
+    prepare(routeU, costEvaluator);
+
+    return d_params.distanceMatrix().visit([&](auto const &distMat) {
+        return evalMove(distMat, routeU, routeV, costEvaluator);
+    });
+}
+
 void SwapStar::apply(Route *U, Route *V)
 {
     if (best.U && best.UAfter && best.V && best.VAfter)
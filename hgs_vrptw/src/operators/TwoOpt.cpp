@@ -5,66 +5,71 @@
 
 using TWS = TimeWindowSegment;
 
-int TwoOpt::evalWithinRoute(Node *U, Node *V)
+template <typename DistMat>
+int TwoOpt::evalWithinRoute(DistMat const &distMat,
+                            Node *U,
+                            Node *V,
+                            CostEvaluator const &costEvaluator)
 {
     if (U->position + 1 >= V->position)
         return 0;
 
-    int deltaCost = d_params.dist(U->client, V->client)
-                    + d_params.dist(n(U)->client, n(V)->client)
-                    + V->cumulatedReversalDistance
-                    - d_params.dist(U->client, n(U)->client)
-                    - d_params.dist(V->client, n(V)->client)
-                    - n(U)->cumulatedReversalDistance;
+    int deltaCost = distMat(U->client, V->client)
+                    + distMat(n(U)->client, n(V)->client)
+                    + V->cumulatedReversalDistance()
+                    - distMat(U->client, n(U)->client)
+                    - distMat(V->client, n(V)->client)
+                    - n(U)->cumulatedReversalDistance();
 
     if (!U->route->hasTimeWarp() && deltaCost >= 0)
         return deltaCost;
 
-    auto tws = U->twBefore;
-    auto *itRoute = V;
-    while (itRoute != U)
-    {
-        tws = TWS::merge(tws, itRoute->tw);
-        itRoute = p(itRoute);
-    }
-
-    tws = TWS::merge(tws, n(V)->twAfter);
+    auto const *route = U->route;
+    auto const tws = TWS::merge(
+        distMat,
+        U->twBefore(),
+        route->twBetweenReversed(n(U)->position, V->position),
+        n(V)->twAfter());
 
-    deltaCost += d_params.twPenalty(tws.totalTimeWarp());
-    deltaCost -= d_params.twPenalty(U->route->timeWarp());
+    deltaCost += costEvaluator.twPenalty(tws.totalTimeWarp());
+    deltaCost -= costEvaluator.twPenalty(U->route->timeWarp());
 
     return deltaCost;
 }
 
-int TwoOpt::evalBetweenRoutes(Node *U, Node *V)
+template <typename DistMat>
+int TwoOpt::evalBetweenRoutes(DistMat const &distMat,
+                              Node *U,
+                              Node *V,
+                              CostEvaluator const &costEvaluator)
 {
-    int const current = d_params.dist(U->client, n(U)->client)
-                        + d_params.dist(V->client, n(V)->client);
-    int const proposed = d_params.dist(U->client, n(V)->client)
-                         + d_params.dist(V->client, n(U)->client);
+    int const current = distMat(U->client, n(U)->client)
+                        + distMat(V->client, n(V)->client);
+    int const proposed = distMat(U->client, n(V)->client)
+                         + distMat(V->client, n(U)->client);
 
     int deltaCost = proposed - current;
 
     if (U->route->isFeasible() && V->route->isFeasible() && deltaCost >= 0)
         return deltaCost;
 
-    auto const uTWS = TWS::merge(U->twBefore, n(V)->twAfter);
+    auto const uTWS = TWS::merge(distMat, U->twBefore(), n(V)->twAfter());
 
-    deltaCost += d_params.twPenalty(uTWS.totalTimeWarp());
-    deltaCost -= d_params.twPenalty(U->route->timeWarp());
+    deltaCost += costEvaluator.twPenalty(uTWS.totalTimeWarp());
+    deltaCost -= costEvaluator.twPenalty(U->route->timeWarp());
 
-    auto const vTWS = TWS::merge(V->twBefore, n(U)->twAfter);
+    auto const vTWS = TWS::merge(distMat, V->twBefore(), n(U)->twAfter());
 
-    deltaCost += d_params.twPenalty(vTWS.totalTimeWarp());
-    deltaCost -= d_params.twPenalty(V->route->timeWarp());
+    deltaCost += costEvaluator.twPenalty(vTWS.totalTimeWarp());
+    deltaCost -= costEvaluator.twPenalty(V->route->timeWarp());
 
-    int const deltaLoad = U->cumulatedLoad - V->cumulatedLoad;
+    int const deltaLoad = U->cumulatedLoad() - V->cumulatedLoad();
 
-    deltaCost += d_params.loadPenalty(U->route->load() - deltaLoad);
-    deltaCost -= d_params.loadPenalty(U->route->load());
+    deltaCost += costEvaluator.loadPenalty(U->route->load() - deltaLoad);
+    deltaCost -= costEvaluator.loadPenalty(U->route->load());
 
-    deltaCost += d_params.loadPenalty(V->route->load() + deltaLoad);
-    deltaCost -= d_params.loadPenalty(V->route->load());
+    deltaCost += costEvaluator.loadPenalty(V->route->load() + deltaLoad);
+    deltaCost -= costEvaluator.loadPenalty(V->route->load());
 
     return deltaCost;
 }
@@ -108,13 +113,16 @@ void TwoOpt::applyBetweenRoutes(Node *U, Node *V)
     }
 }
 
-int TwoOpt::evaluate(Node *U, Node *V)
+int TwoOpt::evaluate(Node *U, Node *V, CostEvaluator const &costEvaluator)
 {
     if (U->route->idx > V->route->idx)  // will be tackled in a later iteration
         return 0;                       // - no need to process here already
 
-    return U->route == V->route ? evalWithinRoute(U, V)
-                                : evalBetweenRoutes(U, V);
+    return d_params.distanceMatrix().visit([&](auto const &distMat) {
+        return U->route == V->route
+                   ? evalWithinRoute(distMat, U, V, costEvaluator)
+                   : evalBetweenRoutes(distMat, U, V, costEvaluator);
+    });
 }
 
 void TwoOpt::apply(Node *U, Node *V)
@@ -0,0 +1,72 @@
+#include "solveBatch.h"
+
+#include "CostEvaluator.h"
+#include "LocalSearch.h"
+#include "Population.h"
+#include "TaskScheduler.h"
+#include "XorShift128.h"
+
+#include <memory>
+#include <optional>
+
+namespace
+{
+Result solve(Params const &params,
+             std::vector<LocalSearchOperator<Node> const *> const &nodeOps,
+             std::vector<LocalSearchOperator<Route> const *> const &routeOps,
+             std::vector<GeneticAlgorithm::xOp> const &crossoverOps,
+             StoppingCriterion const &stop)
+{
+    XorShift128 rng(params.config.seed);
+    Population population(params, rng, CostEvaluator(params));
+    LocalSearch localSearch(params, rng);
+
+    std::vector<std::unique_ptr<LocalSearchOperator<Node>>> ownedNodeOps;
+    for (auto const *op : nodeOps)
+    {
+        ownedNodeOps.push_back(op->clone(params));
+        localSearch.addNodeOperator(*ownedNodeOps.back());
+    }
+
+    std::vector<std::unique_ptr<LocalSearchOperator<Route>>> ownedRouteOps;
+    for (auto const *op : routeOps)
+    {
+        ownedRouteOps.push_back(op->clone(params));
+        localSearch.addRouteOperator(*ownedRouteOps.back());
+    }
+
+    GeneticAlgorithm algo(params, rng, population, localSearch);
+    for (auto const &op : crossoverOps)
+        algo.addCrossoverOperator(op);
+
+    auto criterion = stop.clone();
+    return algo.run(*criterion);
+}
+}  // namespace
+
+std::vector<Result>
+solveBatch(std::vector<Params const *> const &instances,
+           std::vector<LocalSearchOperator<Node> const *> const &nodeOps,
+           std::vector<LocalSearchOperator<Route> const *> const &routeOps,
+           std::vector<GeneticAlgorithm::xOp> const &crossoverOps,
+           StoppingCriterion const &stop)
+{
+    // Result is not default constructible, so we first store the results in
+    // optionals, and unpack those once all instances have been solved.
+    std::vector<std::optional<Result>> results(instances.size());
+
+    // Each instance is solved in its own task. Idle threads steal tasks, which
+    // balances the load when some instances take longer than others.
+    TaskScheduler::shared()->parallelFor(instances.size(), [&](size_t idx) {
+        results[idx].emplace(
+            solve(*instances[idx], nodeOps, routeOps, crossoverOps, stop));
+    });
+
+    std::vector<Result> solved;
+    solved.reserve(results.size());
+
+    for (auto &result : results)
+        solved.push_back(std::move(*result));
+
+    return solved;
+}
@@ -0,0 +1,76 @@
+// Tests that adding individuals to a population that has reached its maximum
+// size does not allocate memory, also when the shared task scheduler has more
+// than one thread.
+
+#include "Config.h"
+#include "CostEvaluator.h"
+#include "Individual.h"
+#include "Params.h"
+#include "Population.h"
+#include "RandomParams.h"
+#include "TaskScheduler.h"
+#include "XorShift128.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <vector>
+
+namespace
+{
+std::atomic<size_t> nbAllocations = 0;
+}  // namespace
+
+// Counts all allocations. The matching operator delete is the default one.
+void *operator new(size_t size)
+{
+    nbAllocations++;
+
+    if (auto *ptr = std::malloc(size))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
+
+int main()
+{
+    TaskScheduler::setSharedThreads(4);
+
+    Config config;
+    XorShift128 rng(1);
+    auto const params = randomParams(config, 200, rng);
+
+    CostEvaluator costEvaluator(params);
+    Population pop(params, rng, costEvaluator);
+
+    // The individuals are created up front, since creating them allocates.
+    std::vector<Individual> indivs;
+    for (int count = 0; count != 1000; ++count)
+        indivs.emplace_back(&params, &rng);
+
+    // The first half fills the population and its pool; the second half is
+    // the steady state.
+    for (size_t idx = 0; idx != indivs.size() / 2; ++idx)
+        pop.addIndividual(indivs[idx], costEvaluator);
+
+    auto const before = nbAllocations.load();
+
+    for (size_t idx = indivs.size() / 2; idx != indivs.size(); ++idx)
+        pop.addIndividual(indivs[idx], costEvaluator);
+
+    auto const allocated = nbAllocations - before;
+
+    if (allocated != 0)
+    {
+        std::cerr << "FAILED: " << allocated << " allocations in "
+                  << indivs.size() / 2 << " steady state inserts\n";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
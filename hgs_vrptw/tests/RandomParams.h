@@ -0,0 +1,51 @@
+#ifndef RANDOMPARAMS_H
+#define RANDOMPARAMS_H
+
+#include "Config.h"
+#include "Params.h"
+#include "XorShift128.h"
+
+#include <cmath>
+#include <vector>
+
+// Returns the parameters of a random instance with the given number of
+// clients. The clients are placed uniformly at random on a 1000 x 1000 grid,
+// and the distance matrix holds the rounded Euclidean distances. All clients
+// have unit demand, and the same wide time window.
+inline Params
+randomParams(Config const &config, int nbClients, XorShift128 &rng)
+{
+    std::vector<std::pair<int, int>> coords;
+    for (int i = 0; i <= nbClients; ++i)
+        coords.emplace_back(rng.randint(1000), rng.randint(1000));
+
+    std::vector<std::vector<int>> distMat(nbClients + 1,
+                                          std::vector<int>(nbClients + 1));
+
+    for (int i = 0; i <= nbClients; ++i)
+        for (int j = 0; j <= nbClients; ++j)
+        {
+            auto const dx = coords[i].first - coords[j].first;
+            auto const dy = coords[i].second - coords[j].second;
+            distMat[i][j] = std::lround(std::hypot(dx, dy));
+        }
+
+    std::vector<int> demands(nbClients + 1, 1);
+    std::vector<std::pair<int, int>> timeWindows(nbClients + 1, {0, 100'000});
+    std::vector<int> servDurs(nbClients + 1, 10);
+    std::vector<int> releases(nbClients + 1, 0);
+
+    demands[0] = 0;
+    servDurs[0] = 0;
+
+    return Params(config,
+                  coords,
+                  demands,
+                  nbClients,
+                  timeWindows,
+                  servDurs,
+                  distMat,
+                  releases);
+}
+
+#endif  // RANDOMPARAMS_H
@@ -0,0 +1,111 @@
+// Tests that the number of threads of the shared task scheduler cannot be
+// changed while a genetic algorithm runs on another thread, and that it can be
+// changed again once the run is done.
+
+#include "Config.h"
+#include "CostEvaluator.h"
+#include "Exchange.h"
+#include "GeneticAlgorithm.h"
+#include "LocalSearch.h"
+#include "Params.h"
+#include "Population.h"
+#include "RandomParams.h"
+#include "StoppingCriterion.h"
+#include "TaskScheduler.h"
+#include "XorShift128.h"
+#include "crossover.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+// Stopping criterion that signals when it is first evaluated (so the run has
+// started), and stops the run once it is released.
+class Latch : public StoppingCriterion
+{
+    std::atomic<bool> &started;
+    std::atomic<bool> &released;
+
+public:
+    Latch(std::atomic<bool> &started, std::atomic<bool> &released)
+        : started(started), released(released)
+    {
+    }
+
+    bool operator()() override
+    {
+        started = true;
+        return released;
+    }
+
+    [[nodiscard]] std::unique_ptr<StoppingCriterion> clone() const override
+    {
+        return std::make_unique<Latch>(started, released);
+    }
+};
+
+bool check(bool condition, char const *message)
+{
+    if (!condition)
+        std::cerr << "FAILED: " << message << '\n';
+
+    return condition;
+}
+}  // namespace
+
+int main()
+{
+    TaskScheduler::setSharedThreads(2);
+
+    Config config;
+    XorShift128 rng(1);
+    auto const params = randomParams(config, 50, rng);
+
+    CostEvaluator costEvaluator(params);
+    Population pop(params, rng, costEvaluator);
+    LocalSearch ls(params, rng);
+
+    auto exchange10 = Exchange<1, 0>(params);
+    ls.addNodeOperator(exchange10);
+
+    GeneticAlgorithm algo(params, rng, pop, ls);
+    algo.addCrossoverOperator(selectiveRouteExchange);
+
+    std::atomic<bool> started = false;
+    std::atomic<bool> released = false;
+    Latch stop(started, released);
+
+    std::thread runner([&]() { algo.run(stop); });
+
+    while (!started)
+        std::this_thread::yield();
+
+    bool threw = false;
+
+    try
+    {
+        TaskScheduler::setSharedThreads(4);
+    }
+    catch (std::runtime_error const &)
+    {
+        threw = true;
+    }
+
+    released = true;
+    runner.join();
+
+    bool ok = check(threw, "changing the threads during a run throws");
+    ok &= check(TaskScheduler::shared()->numThreads() == 2,
+                "the scheduler is unchanged by the failed call");
+
+    TaskScheduler::setSharedThreads(4);
+    ok &= check(TaskScheduler::shared()->numThreads() == 4,
+                "the threads can be changed once the run is done");
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
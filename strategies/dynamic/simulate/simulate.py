@@ -1,7 +1,9 @@
+from math import ceil
+
 import numpy as np
 
 import hgspy
-from strategies.static import hgs
+from strategies.static import hgs_batch
 from strategies.utils import filter_instance
 from .simulate_instance import simulate_instance
 
@@ -24,7 +26,8 @@ def simulate(
 ):
     """
     Determine the dispatch instance by simulating the next epochs and analyzing
-    those simulations.
+    those simulations. The simulations of each cycle are solved concurrently,
+    on the threads of the solver's task scheduler.
     """
     # Return the full epoch instance for the last epoch
     if obs["current_epoch"] == info["end_epoch"]:
@@ -35,7 +38,15 @@ def simulate(
     n_ep_reqs = ep_inst["is_depot"].size
     must_dispatch = set(np.flatnonzero(ep_inst["must_dispatch"]))
     total_sim_tlim = simulate_tlim_factor * info["epoch_tlim"]
-    single_sim_tlim = total_sim_tlim / (n_cycles * n_simulations)
+    cycle_tlim = total_sim_tlim / n_cycles
+
+    # At most this many simulations are solved at the same time. Each solve
+    # gets an equal share of the cycle's time, but the cycle as a whole is
+    # also bounded (see below), in case solves cannot run as concurrently as
+    # assumed here.
+    n_concurrent = max(min(hgspy.get_num_threads(), n_simulations), 1)
+    n_rounds = ceil(n_simulations / n_concurrent)  # sequential solves
+    single_sim_tlim = cycle_tlim / n_rounds
 
     dispatch_count = np.zeros(n_ep_reqs, dtype=int)
     to_postpone = np.zeros(n_ep_reqs, dtype=bool)
@@ -47,8 +58,8 @@ def simulate(
     postpone_threshold = postpone_thresholds[min(epoch, num_thresholds - 1)]
 
     for _ in range(n_cycles):
-        for _ in range(n_simulations):
-            sim_inst = simulate_instance(
+        sim_insts = [
+            simulate_instance(
                 info,
                 obs,
                 rng,
@@ -56,16 +67,23 @@ def simulate(
                 n_requests,
                 ep_release=to_postpone * 3600,
             )
+            for _ in range(n_simulations)
+        ]
 
-            res = hgs(
-                sim_inst,
-                hgspy.Config(**sim_config),
-                [getattr(hgspy.operators, op) for op in node_ops],
-                [getattr(hgspy.operators, op) for op in route_ops],
-                [getattr(hgspy.crossover, op) for op in crossover_ops],
-                hgspy.stop.MaxRuntime(single_sim_tlim),
-            )
+        # Each solve stops after single_sim_tlim seconds from its own start,
+        # or cycle_tlim seconds after the start of the batch, whichever comes
+        # first.
+        stop = hgspy.stop.MaxRuntime(single_sim_tlim, cycle_tlim)
+        results = hgs_batch(
+            sim_insts,
+            hgspy.Config(**sim_config),
+            [getattr(hgspy.operators, op) for op in node_ops],
+            [getattr(hgspy.operators, op) for op in route_ops],
+            [getattr(hgspy.crossover, op) for op in crossover_ops],
+            stop,
+        )
 
+        for res in results:
             best = res.get_best_found()
 
             for sim_route in best.get_routes():
@@ -1 +1 @@
-from .hgs import hgs
+from .hgs import hgs, hgs_batch
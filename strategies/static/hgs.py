@@ -14,13 +14,12 @@ def hgs(
     params = hgspy.Params(config, **tools.inst_to_vars(instance))
 
     rng = hgspy.XorShift128(seed=config.seed)
-    pop = hgspy.Population(params, rng)
+    cost_evaluator = hgspy.CostEvaluator(params)
+    pop = hgspy.Population(params, rng, cost_evaluator)
 
     for sol in initial_solutions:
-        pop.add_individual(hgspy.Individual(params, sol))
+        pop.add_individual(hgspy.Individual(params, sol), cost_evaluator)
 
-    # These operators need to be stored somewhere for the lifetime of the algo,
-    # since the cpp side only takes a (non-owning) reference.
     node_ops = [op(params) for op in node_ops]
     route_ops = [op(params) for op in route_ops]
 
@@ -38,3 +37,33 @@ def hgs(
         algo.add_crossover_operator(op)
 
     return algo.run(stop)
+
+
+def hgs_batch(
+    instances,
+    config,
+    node_ops,
+    route_ops,
+    crossover_ops,
+    stop,
+):
+    """
+    Solves the given instances independently, concurrently on the threads of
+    the solver's task scheduler (see ``hgspy.set_num_threads``). The GIL is
+    released while solving. Returns a list of results, one for each instance.
+    Each solve starts from a fresh copy of the stopping criterion.
+    """
+    if len(instances) == 0:
+        return []
+
+    params = [
+        hgspy.Params(config, **tools.inst_to_vars(instance))
+        for instance in instances
+    ]
+
+    # The C++ side copies these operators for each instance, so the parameters
+    # used to construct them here are not relevant.
+    node_ops = [op(params[0]) for op in node_ops]
+    route_ops = [op(params[0]) for op in route_ops]
+
+    return hgspy.solve_batch(params, node_ops, route_ops, crossover_ops, stop)